@@ -34,8 +34,10 @@
 #include "keys.h"
 
 #include "get_git_commit.h"
+#include "get_parser_counters.h"
 #include "get_pubkey.h"
 #include "get_version.h"
+#include "parse_operation.h"
 #include "sign.h"
 
 #define CLA 0x80  /// The only APDU class that will be used
@@ -47,11 +49,17 @@
 #define INS_SIGN              0x04
 #define INS_GIT               0x09
 #define INS_SIGN_WITH_HASH    0x0F
+#if defined(TEZOS_DEBUG) && defined(TZ_PARSER_COUNTERS)
+#define INS_GET_PARSER_COUNTERS 0x10
+#endif
+#define INS_PARSE_OPERATION 0x11
 
 /// Packet indexes
-#define P1_FIRST       0x00u  /// First packet
-#define P1_NEXT        0x01u  /// Other packet
-#define P1_LAST_MARKER 0x80u  /// Last packet
+#define P1_FIRST           0x00u  /// First packet
+#define P1_NEXT            0x01u  /// Other packet
+#define P1_RESTREAM_MARKER 0x20u  /// The host can send the message again
+#define P1_SESSION_MARKER  0x40u  /// Signing session packet
+#define P1_LAST_MARKER     0x80u  /// Last packet
 
 /// Parameters parser helpers
 #define ASSERT_GLOBAL_STEP(_step) \
@@ -85,25 +93,47 @@ dispatch_sign_instruction(const command_t *cmd)
     TZ_ASSERT(EXC_UNEXPECTED_STATE,
               (cmd->ins == INS_SIGN_WITH_HASH) || (cmd->ins == INS_SIGN));
 
-    bool return_hash = cmd->ins == INS_SIGN_WITH_HASH;
+    bool    return_hash = cmd->ins == INS_SIGN_WITH_HASH;
+    bool    last        = (cmd->p1 & P1_LAST_MARKER) != 0;
+    bool    restream    = (cmd->p1 & P1_RESTREAM_MARKER) != 0;
+    uint8_t index       = cmd->p1 & ~(P1_LAST_MARKER | P1_RESTREAM_MARKER);
 
-    if ((cmd->p1 & ~P1_LAST_MARKER) == P1_FIRST) {
+    if (index == P1_FIRST) {
         TZ_ASSERT(EXC_UNEXPECTED_STATE,
                   (global.step == ST_IDLE) || (global.step == ST_SWAP_SIGN));
 
         READ_P2_DERIVATION_TYPE(cmd, derivation_type);
         READ_DATA(cmd, buf);
 
-        TZ_CHECK(
-            handle_signing_key_setup(&buf, derivation_type, return_hash));
+        close_signing_session();
+
+        TZ_CHECK(handle_signing_key_setup(&buf, derivation_type, return_hash,
+                                          restream));
+    } else if (index == (P1_SESSION_MARKER | P1_FIRST)) {
+        // no signing session during swap
+        ASSERT_GLOBAL_STEP(ST_IDLE);
+
+        READ_P2_DERIVATION_TYPE(cmd, derivation_type);
+        READ_DATA(cmd, buf);
+
+        TZ_CHECK(handle_signing_session_setup(&buf, derivation_type,
+                                              return_hash, restream));
+    } else if (index == (P1_SESSION_MARKER | P1_NEXT)) {
+        ASSERT_GLOBAL_STEP(ST_IDLE);
+
+        READ_P2_DERIVATION_TYPE(cmd, derivation_type);
+        READ_DATA(cmd, buf);
+
+        TZ_CHECK(handle_signing_session_sign(&buf, derivation_type, last,
+                                             return_hash, restream));
     } else {
         TZ_ASSERT(EXC_UNEXPECTED_STATE,
                   (global.step == ST_BLIND_SIGN)
                       || (global.step == ST_CLEAR_SIGN)
                       || (global.step == ST_SUMMARY_SIGN)
                       || (global.step == ST_SWAP_SIGN));
-
-        bool last = (cmd->p1 & P1_LAST_MARKER) != 0;
+        // only the first packet tells whether the host can re-stream
+        TZ_ASSERT(EXC_WRONG_PARAM, !restream);
 
         READ_DATA(cmd, buf);
 
@@ -122,6 +152,12 @@ dispatch(const command_t *cmd)
         TZ_FAIL(EXC_CLASS);
     }
 
+    // the host abandoned the dry run: it must not block the next ones
+    if ((global.step == ST_PARSE) && (cmd->ins != INS_PARSE_OPERATION)) {
+        PRINTF("[DEBUG] dry run aborted by instruction 0x%02x\n", cmd->ins);
+        global.step = ST_IDLE;
+    }
+
     switch (cmd->ins) {
     case INS_VERSION:
 
@@ -162,6 +198,32 @@ dispatch(const command_t *cmd)
         TZ_CHECK(dispatch_sign_instruction(cmd));
         break;
     }
+    case INS_PARSE_OPERATION: {
+        bool    last  = (cmd->p1 & P1_LAST_MARKER) != 0;
+        uint8_t index = cmd->p1 & ~P1_LAST_MARKER;
+
+        if (index == P1_FIRST) {
+            TZ_ASSERT(EXC_UNEXPECTED_STATE,
+                      (global.step == ST_IDLE) || (global.step == ST_PARSE));
+        } else {
+            TZ_ASSERT(EXC_WRONG_PARAM, index == P1_NEXT);
+            ASSERT_GLOBAL_STEP(ST_PARSE);
+        }
+        ASSERT_NO_P2(cmd);
+        READ_DATA(cmd, buf);
+
+        TZ_CHECK(handle_parse_operation(&buf, index == P1_FIRST, last));
+        break;
+    }
+#if defined(TEZOS_DEBUG) && defined(TZ_PARSER_COUNTERS)
+    case INS_GET_PARSER_COUNTERS:
+
+        ASSERT_GLOBAL_STEP(ST_IDLE);
+
+        TZ_CHECK(handle_get_parser_counters(cmd->p1, cmd->p2));
+
+        break;
+#endif
     default:
         PRINTF("[ERROR] invalid instruction 0x%02x\n", cmd->ins);
         TZ_FAIL(EXC_INVALID_INS);
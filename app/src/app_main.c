@@ -67,6 +67,17 @@ print_memory_layout(void)
     PRINTF("[SIZEOF] G_io_app: %d\n", sizeof(G_io_app));
 }
 
+#ifdef HAVE_BAGL
+void
+app_ticker_event_callback(void)
+{
+    // use idle time to build the next screen of a clear signing review
+    if (global.step == ST_CLEAR_SIGN) {
+        tz_ui_stream_prefetch();
+    }
+}
+#endif
+
 void
 app_main(void)
 {
@@ -93,6 +104,8 @@ app_main(void)
 #endif
         if (global.step == ST_ERROR) {
             global.step = ST_IDLE;
+            // errors and rejections also end the signing session
+            close_signing_session();
             ui_home_init();
         }
 
@@ -23,3 +23,12 @@
 
 void app_main(void);
 void app_exit(void);
+
+#ifdef HAVE_BAGL
+/**
+ * @brief Called by the SDK on each ticker event, while the application
+ * waits for a command or a button press.
+ *
+ */
+void app_ticker_event_callback(void);
+#endif
@@ -24,6 +24,8 @@
 #include <os.h>
 
 #define SW_OK 0x9000u
+/// The message to sign must be sent again from its start
+#define SW_RESTREAM 0x9100u
 
 // Standard APDU error codes:
 // https://www.eftlab.com/knowledge-base/complete-list-of-apdu-responses
@@ -32,6 +32,7 @@
 #define TZ_SCREEN_LINES_11PX 5
 #endif
 
+#include "parse_operation.h"
 #include "sign.h"
 #include "exception.h"
 #include "keys.h"
@@ -63,6 +64,7 @@ typedef enum {
     ST_SUMMARY_SIGN,  /// Summary signing an operation
     ST_PROMPT,        /// Waiting for user prompt
     ST_SWAP_SIGN,     /// Performing swap operations
+    ST_PARSE,         /// Dry-run parsing an operation
     ST_ERROR          /// In error state.
 } main_step_t;
 
@@ -95,6 +97,7 @@ typedef struct {
             pubkey;  /// UX and UI information related to public key
     } ui;
     bip32_path_with_curve_t path_with_curve;  /// Derivation path
+    sign_session_t          sign_session;     /// Signing session
     union {
         struct {
             apdu_hash_state_t hash;  /// Transaction hash
@@ -106,6 +109,7 @@ typedef struct {
          * currently.
          * */
         cx_ecfp_public_key_t pubkey;
+        apdu_parse_state_t   parse;  /// state of dry-run parsing
     } keys;
     /// Buffer to store incoming data.
     char line_buf[TZ_UI_STREAM_CONTENTS_SIZE + 1];
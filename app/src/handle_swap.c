@@ -220,6 +220,49 @@ swap_check_validity(void)
     TZ_POSTAMBLE;
 }
 
+/* Only checks what cannot change until the end of the operation: at most
+ * one reveal and one transaction, and the fee only grows. */
+bool
+swap_check_field(tz_operation_field_kind kind)
+{
+    tz_operation_state *op
+        = &global.keys.apdu.sign.u.clear.parser_state.operation;
+    char dstaddr[ADDRESS_MAX_SIZE];
+
+    if ((op->nb_reveal > 1) || ((op->batch_index - op->nb_reveal) > 1)
+        || ((op->last_tag != TZ_OPERATION_TAG_REVEAL)
+            && (op->last_tag != TZ_OPERATION_TAG_TRANSACTION))) {
+        PRINTF("[ERROR] Unexpected operation in swap: tag=%d\n",
+               op->last_tag);
+        return false;
+    }
+
+    switch (kind) {
+    case TZ_OPERATION_FIELD_DESTINATION:
+        if (tz_format_address(op->destination, 22, dstaddr, sizeof(dstaddr))
+            || strcmp(dstaddr, G_swap_params.destination_address)) {
+            PRINTF("[ERROR] Swap destination mismatch: \"%s\"\n", dstaddr);
+            return false;
+        }
+        break;
+    case TZ_OPERATION_FIELD_AMOUNT:
+        if (op->total_amount != G_swap_params.amount) {
+            PRINTF("[ERROR] Swap amount mismatch\n");
+            return false;
+        }
+        break;
+    case TZ_OPERATION_FIELD_FEE:
+        if (op->total_fee > G_swap_params.fee) {
+            PRINTF("[ERROR] Swap fee exceeded\n");
+            return false;
+        }
+        break;
+    default:
+        break;
+    }
+    return true;
+}
+
 /* Set create_transaction.result and call os_lib_end().
  *
  * Doesn't return */
@@ -235,4 +278,11 @@ void
 swap_check_validity(void)
 {
 }
+
+bool
+swap_check_field(tz_operation_field_kind kind)
+{
+    (void)kind;
+    return true;
+}
 #endif  // HAVE_SWAP
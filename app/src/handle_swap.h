@@ -22,9 +22,25 @@
 
 #pragma once
 
+#include <stdbool.h>
+
+#include "parser/operation_state.h"
+
 /**
  * @brief Called to check the validity of swap params previously communicated
  * by swap_copy_transaction_parameters which is called from Ledger SDK.
  *
  */
 void swap_check_validity(void);
+
+/**
+ * @brief Hook of the operations parser, called during a swap to check
+ *        each decoded field against the swap params as soon as it is
+ *        parsed, without waiting for the end of the operation.
+ *
+ *        `swap_check_validity` still runs on the complete operation.
+ *
+ * @param kind: kind of the field decoded
+ * @return bool: false if the operation cannot match the swap params
+ */
+bool swap_check_field(tz_operation_field_kind kind);
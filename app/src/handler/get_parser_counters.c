@@ -0,0 +1,76 @@
+/* Tezos Ledger application - Handler for getting parser counters
+
+   Copyright 2025 TriliTech <contact@trili.tech>
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+   http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License. */
+
+#if defined(TEZOS_DEBUG) && defined(TZ_PARSER_COUNTERS)
+
+#include <io.h>
+
+#include "get_parser_counters.h"
+
+#include "exception.h"
+#include "globals.h"
+
+/**
+ * @brief Write a 4-bytes big-endian integer
+ *
+ * @param buf: output buffer
+ * @param value: integer to write
+ */
+static void
+write_u32_be_at(uint8_t *buf, uint32_t value)
+{
+    buf[0] = (uint8_t)(value >> 24);
+    buf[1] = (uint8_t)(value >> 16);
+    buf[2] = (uint8_t)(value >> 8);
+    buf[3] = (uint8_t)value;
+}
+
+void
+handle_get_parser_counters(uint8_t table, uint8_t index)
+{
+    TZ_PREAMBLE(("table=%d, index=%d", table, index));
+
+    const tz_parser_counters *counters
+        = &global.keys.apdu.sign.u.clear.parser_state.counters;
+    const tz_parser_counter *counter;
+    uint8_t                  resp[12];
+
+    switch (table) {
+    case PARSER_COUNTERS_OPERATION_STEPS:
+        TZ_ASSERT(EXC_WRONG_PARAM, index < TZ_OPERATION_STEP_COUNT);
+        counter = &counters->operation_steps[index];
+        break;
+    case PARSER_COUNTERS_MICHELINE_STEPS:
+        TZ_ASSERT(EXC_WRONG_PARAM, index < TZ_MICHELINE_STEP_COUNT);
+        counter = &counters->micheline_steps[index];
+        break;
+    case PARSER_COUNTERS_OPERATION_TAGS:
+        TZ_ASSERT(EXC_WRONG_PARAM, index <= TZ_OPERATION_TAG_COUNT);
+        counter = &counters->operation_tags[index];
+        break;
+    default:
+        TZ_FAIL(EXC_WRONG_PARAM);
+    }
+
+    write_u32_be_at(resp, counter->steps);
+    write_u32_be_at(resp + 4, counter->bytes);
+    write_u32_be_at(resp + 8, counter->chars);
+    io_send_response_pointer(resp, sizeof(resp), SW_OK);
+
+    TZ_POSTAMBLE;
+}
+
+#endif
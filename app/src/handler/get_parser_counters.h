@@ -0,0 +1,43 @@
+/* Tezos Ledger application - Handler for getting parser counters
+
+   Copyright 2025 TriliTech <contact@trili.tech>
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+   http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License. */
+
+#pragma once
+
+#if defined(TEZOS_DEBUG) && defined(TZ_PARSER_COUNTERS)
+
+#include <stdint.h>
+
+/**
+ * @brief Counters tables of the parser
+ */
+typedef enum {
+    PARSER_COUNTERS_OPERATION_STEPS = 0,  /// per operations parser step
+    PARSER_COUNTERS_MICHELINE_STEPS = 1,  /// per micheline parser step
+    PARSER_COUNTERS_OPERATION_TAGS  = 2   /// per operation tag
+} parser_counters_table_t;
+
+/**
+ * @brief Handle parser counters request.
+ * Send APDU response containing one counter of the last clear
+ * signing: its number of steps, of bytes read and of characters
+ * written, as 4-bytes big-endian integers.
+ *
+ * @param table: counters table
+ * @param index: index of the counter in the table
+ */
+void handle_get_parser_counters(uint8_t table, uint8_t index);
+
+#endif
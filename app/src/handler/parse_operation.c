@@ -0,0 +1,144 @@
+/* Tezos Ledger application - Handler for dry-run parsing
+
+   Copyright 2025 TriliTech <contact@trili.tech>
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+   http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License. */
+
+#include <io.h>
+#include <write.h>
+
+#include "parse_operation.h"
+
+#include "exception.h"
+#include "globals.h"
+
+#include "parser/operation_parser.h"
+
+#define PARSE global.keys.parse
+
+/// Length of the reply: screens, fields, batch index, amount, fee and
+/// result
+#define PARSE_RESULT_SIZE (4 + 4 + 2 + 8 + 8 + 1)
+
+/**
+ * @brief Account for the field in the output buffer, as
+ *        `refill_blo_im_full` would display it, and flush what the
+ *        screen displays
+ */
+static void
+count_screen(void)
+{
+    tz_parser_state *st = &PARSE.parser_state;
+
+    if (st->field_info.field_index != PARSE.last_field_index) {
+        PARSE.last_field_index = st->field_info.field_index;
+        PARSE.fields++;
+    }
+#ifdef HAVE_BAGL
+    if (st->field_info.is_field_complex && !PARSE.warned) {
+        PARSE.warned = true;
+        PARSE.screens++;
+    }
+    PARSE.screens++;
+    tz_parser_flush_up_to(st, global.line_buf, TZ_UI_STREAM_CONTENTS_SIZE,
+                          tz_ui_stream_fit(global.line_buf));
+#elif HAVE_NBGL
+    // fields are laid out in pages when displayed: screens are not
+    // counted
+    tz_parser_flush(st, global.line_buf, TZ_UI_STREAM_CONTENTS_SIZE);
+#endif
+}
+
+/**
+ * @brief Reply with the result of the parsing and end it
+ */
+static void
+send_result(void)
+{
+    const tz_parser_state    *st = &PARSE.parser_state;
+    const tz_operation_state *op = &st->operation;
+    uint8_t                   resp[PARSE_RESULT_SIZE];
+
+    write_u32_be(resp, 0, PARSE.screens);
+    write_u32_be(resp, 4, PARSE.fields);
+    write_u16_be(resp, 8, op->batch_index);
+    write_u64_be(resp, 10, op->total_amount);
+    write_u64_be(resp, 18, op->total_fee);
+    resp[26] = (uint8_t)st->errno;
+
+    global.step = ST_IDLE;
+    io_send_response_pointer(resp, sizeof(resp), SW_OK);
+}
+
+void
+handle_parse_operation(buffer_t *cdata, bool first, bool last)
+{
+    tz_parser_state *st = &PARSE.parser_state;
+    TZ_PREAMBLE(("cdata=0x%p, first=%d, last=%d", cdata, first, last));
+
+    TZ_ASSERT_NOTNULL(cdata);
+
+    if (first) {
+        tz_operation_parser_init(st, TZ_UNKNOWN_SIZE, false);
+        tz_parser_refill(st, NULL, 0);
+        tz_parser_flush(st, global.line_buf, TZ_UI_STREAM_CONTENTS_SIZE);
+        PARSE.total_length     = 0;
+        PARSE.screens          = 0;
+        PARSE.fields           = 0;
+        PARSE.last_field_index = -1;
+        PARSE.warned           = false;
+        global.step            = ST_PARSE;
+    }
+
+    // check we consume all input before asking for more
+    TZ_ASSERT(EXC_UNEXPECTED_STATE, st->regs.ilen == 0);
+
+    PARSE.total_length += (uint32_t)cdata->size;
+    TZ_ASSERT(EXC_WRONG_LENGTH, PARSE.total_length < TZ_UNKNOWN_SIZE);
+
+    tz_parser_refill(st, cdata->ptr, cdata->size);
+    if (last) {
+        tz_operation_parser_set_size(st, PARSE.total_length);
+    }
+
+    while (true) {
+        tz_operation_parser_run(st, NULL);
+        PRINTF("[DEBUG] parse(errno: %s)\n",
+               tz_parser_result_name(st->errno));
+        switch (st->errno) {
+        case TZ_BLO_IM_FULL:
+            count_screen();
+            break;
+        case TZ_BLO_FEED_ME:
+            if (!last) {
+                io_send_sw(SW_OK);
+                TZ_SUCCEED();
+            }
+            // the operation is truncated
+            send_result();
+            TZ_SUCCEED();
+        case TZ_BLO_DONE:
+            if (st->regs.oofs != 0) {
+                count_screen();
+                break;
+            }
+            send_result();
+            TZ_SUCCEED();
+        default:
+            send_result();
+            TZ_SUCCEED();
+        }
+    }
+
+    TZ_POSTAMBLE;
+}
@@ -0,0 +1,51 @@
+/* Tezos Ledger application - Handler for dry-run parsing
+
+   Copyright 2025 TriliTech <contact@trili.tech>
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+   http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License. */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <buffer.h>
+
+#include "parser/parser_state.h"
+
+/**
+ * @brief This structure represents the state of a dry-run parsing.
+ *
+ */
+typedef struct {
+    tz_parser_state parser_state;      /// parser of the operation
+    uint32_t        total_length;      /// length of the operation received
+    uint32_t        screens;           /// screens the review would display
+    uint32_t        fields;            /// fields the review would display
+    int             last_field_index;  /// field of the last screen counted
+    bool            warned;  /// whether the complex field warning was counted
+} apdu_parse_state_t;
+
+/**
+ * @brief Handle a packet of a dry-run parsing.
+ * Parse the operation as a clear signing would, without any display
+ * and without signing. Reply to the last packet, or as soon as the
+ * parsing stops, with the number of screens and of fields of the
+ * review, the number of operations, the total amount, the total fee
+ * and the parser result.
+ *
+ * @param cdata: data containing the next part of the operation
+ * @param first: whether it is the first packet of the operation
+ * @param last: whether it is the last packet of the operation
+ */
+void handle_parse_operation(buffer_t *cdata, bool first, bool last);
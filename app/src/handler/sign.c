@@ -57,12 +57,17 @@ static void send_cancel(void);
 static void refill(void);
 static void refill_all(void);
 static void stream_cb(tz_ui_cb_type_t cb_type);
+static void init_stream(void (*cb)(tz_ui_cb_type_t cb_type));
+static void init_signing(bool return_hash, bool restream);
 static void start_displaying_signature_review(void);
 static void init_blind_stream(void);
 static void handle_data_apdu_clear(buffer_t *cdata, bool last);
 static void handle_data_apdu_blind(void);
 static void pass_from_clear_to_summary(void);
 #ifdef HAVE_BAGL
+static void prefetch(void);
+static bool can_rewind(void);
+static void rewind_review(void);
 static void init_too_many_screens_stream(void);
 #endif
 #ifdef HAVE_NBGL
@@ -79,6 +84,7 @@ static void init_summary_stream(void);
 
 #ifdef HAVE_BAGL
 #define SCREEN_DISPLAYED global.keys.apdu.sign.u.clear.screen_displayed
+#define CHECKPOINTS      global.keys.apdu.sign.u.clear.checkpoints
 #endif
 
 #ifdef HAVE_BAGL
@@ -184,6 +190,8 @@ send_reject(int error_code)
     TZ_PREAMBLE(("void"));
 
     APDU_SIGN_ASSERT_STEP(SIGN_ST_WAIT_USER_INPUT);
+    // a rejection ends the signing session
+    close_signing_session();
     TZ_FAIL(error_code);
     TZ_POSTAMBLE;
 }
@@ -207,6 +215,111 @@ send_continue(void)
     TZ_POSTAMBLE;
 }
 
+#ifdef HAVE_BAGL
+/**
+ * @brief Predict, on the first screen of each operation, whether the
+ * review is certain to exceed NB_MAX_SCREEN_ALLOWED screens, counting
+ * the screens the operation takes whatever its content.
+ *
+ * @return bool: whether the review is certain to be too long
+ */
+static bool
+too_many_screens_ahead(void)
+{
+    tz_parser_state *st = &global.keys.apdu.sign.u.clear.parser_state;
+    uint16_t *predicted = &global.keys.apdu.sign.u.clear.predicted_ops;
+
+    if ((st->operation.descriptor == NULL)
+        || (st->operation.batch_index < *predicted)) {
+        return false;
+    }
+
+    size_t screens
+        = tz_operation_parser_min_screens(st, TZ_UI_STREAM_CONTENTS_SIZE);
+    PRINTF("[DEBUG] operation %d takes at least %u screens\n",
+           st->operation.batch_index, (unsigned int)screens);
+    if ((SCREEN_DISPLAYED + screens) > NB_MAX_SCREEN_ALLOWED) {
+        // asking again gives the same answer until the screen is built
+        return true;
+    }
+    *predicted = st->operation.batch_index + 1;
+    return false;
+}
+
+/**
+ * @brief Check whether the review goes on with the summary instead of
+ * the screen the parser just filled.
+ *
+ * @return bool: whether the review switches to the summary
+ */
+static bool
+needs_summary(void)
+{
+    return N_settings.blindsigning
+           && ((SCREEN_DISPLAYED >= NB_MAX_SCREEN_ALLOWED)
+               || too_many_screens_ahead());
+}
+
+/**
+ * @brief Hash of the part of the message received so far.
+ *
+ * @param hash: output buffer
+ */
+static void
+hash_received(uint8_t hash[SIGN_HASH_SIZE])
+{
+    cx_blake2b_t state;
+    TZ_PREAMBLE(("hash=%p", hash));
+
+    if (global.keys.apdu.sign.received_last_msg) {
+        memcpy(hash, global.keys.apdu.hash.final_hash, SIGN_HASH_SIZE);
+        TZ_SUCCEED();
+    }
+    // the message goes on: finalize a copy of its hash
+    memcpy(&state, &global.keys.apdu.hash.state, sizeof(state));
+    CX_CHECK(cx_hash_no_throw((cx_hash_t *)&state, CX_LAST, NULL, 0, hash,
+                              SIGN_HASH_SIZE));
+
+    TZ_POSTAMBLE;
+}
+
+/**
+ * @brief Take the checkpoint of the operation whose first screen is
+ * pushed next, if not taken yet. The checkpoint of the first operation
+ * is kept, the others replace the oldest ones.
+ */
+static void
+take_checkpoint(void)
+{
+    tz_parser_state *st    = &global.keys.apdu.sign.u.clear.parser_state;
+    uint16_t        *count = &global.keys.apdu.sign.u.clear.nb_checkpoints;
+    TZ_PREAMBLE(("void"));
+
+    if ((st->operation.descriptor == NULL)
+        || (st->operation.checkpoint.batch_index != *count)) {
+        TZ_SUCCEED();
+    }
+
+    sign_checkpoint_t *cp = &CHECKPOINTS[0];
+    if (*count > 0) {
+        cp = &CHECKPOINTS[1 + ((*count - 1) % (SIGN_CHECKPOINTS - 1))];
+    }
+    cp->parser           = st->operation.checkpoint;
+    cp->screen           = tz_ui_stream_next();
+    cp->screen_displayed = SCREEN_DISPLAYED;
+    cp->last_field_index = global.keys.apdu.sign.u.clear.last_field_index;
+    cp->displayed_expert_warning
+        = global.keys.apdu.sign.u.clear.displayed_expert_warning;
+    // the APDU holding the tag has been received and hashed
+    TZ_CHECK(hash_received(cp->hash));
+    cp->hashed_length
+        = (uint32_t)global.keys.apdu.sign.u.clear.total_length;
+    (*count)++;
+
+    TZ_POSTAMBLE;
+}
+#endif
+
 static void
 refill_blo_im_full(void)
 {
@@ -214,7 +327,8 @@ refill_blo_im_full(void)
     size_t           wrote = 0;
     TZ_PREAMBLE(("void"));
 
-    // No display for Swap or Summary flow
+    // No display for Swap or Summary flow: the parser does not render
+    // fields anymore, only discard what was printed before
     if (
 #ifdef HAVE_SWAP
         G_called_from_swap ||
@@ -227,11 +341,11 @@ refill_blo_im_full(void)
 
     global.keys.apdu.sign.step = SIGN_ST_WAIT_USER_INPUT;
 #ifdef HAVE_BAGL
-    if (N_settings.blindsigning
-        && (SCREEN_DISPLAYED >= NB_MAX_SCREEN_ALLOWED)) {
+    if (needs_summary()) {
         pass_from_clear_to_summary();
         TZ_SUCCEED();
     }
+    TZ_CHECK(take_checkpoint());
 
     if (st->field_info.is_field_complex && !N_settings.expert_mode) {
         tz_ui_stream_push(TZ_UI_STREAM_CB_NOCB, st->field_info.field_name,
@@ -339,13 +453,18 @@ refill_error(void)
 #ifdef HAVE_SWAP
     if (G_called_from_swap) {
         global.keys.apdu.sign.u.clear.received_msg = false;
+        if (st->errno == TZ_ERR_REJECTED) {
+            // the swap is over, as when swap_check_validity fails
+            G_swap_response_ready = true;
+            TZ_FAIL(EXC_REJECT);
+        }
         TZ_FAIL(EXC_PARSE_ERROR);
     }
 #endif
 
     // clang-format off
 #ifdef HAVE_BAGL
-    tz_ui_stream_init(stream_cb);
+    init_stream(stream_cb);
 
 #ifdef TARGET_NANOS
     tz_ui_stream_push_warning_not_trusted(NULL, NULL);
@@ -401,8 +520,15 @@ refill(void)
     tz_parser_state *st = &global.keys.apdu.sign.u.clear.parser_state;
     TZ_PREAMBLE(("void"));
 
-    while (!TZ_IS_BLOCKED(tz_operation_parser_step(st))) {
-        // Loop while the result is successful and not blocking
+    // a result held by the prefetch is handled without parsing further
+#ifdef HAVE_BAGL
+    bool held = global.keys.apdu.sign.u.clear.held_result;
+    global.keys.apdu.sign.u.clear.held_result = false;
+#else
+    bool held = false;
+#endif
+    if (!held) {
+        tz_operation_parser_run(st, NULL);
     }
     PRINTF("[DEBUG] refill(errno: %s)\n", tz_parser_result_name(st->errno));
     // clang-format off
@@ -420,6 +546,158 @@ refill(void)
     TZ_POSTAMBLE;
 }
 
+#ifdef HAVE_BAGL
+/**
+ * @brief Build the next content screen of the review while the user
+ * reads the current one, so that the right button only has to display
+ * it.
+ *
+ * Only content screens are built ahead. Anything else is held until
+ * the user asks for the next screen: the request for the next part of
+ * the message, the final screens, a parsing error and a switch to the
+ * summary.
+ */
+static void
+prefetch(void)
+{
+    tz_parser_state *st = &global.keys.apdu.sign.u.clear.parser_state;
+    TZ_PREAMBLE(("void"));
+
+    if ((global.keys.apdu.sign.step != SIGN_ST_WAIT_USER_INPUT)
+        || global.keys.apdu.sign.u.clear.held_result) {
+        TZ_SUCCEED();
+    }
+
+    tz_operation_parser_run(st, NULL);
+    PRINTF("[DEBUG] prefetch(errno: %s)\n",
+           tz_parser_result_name(st->errno));
+    switch (st->errno) {
+    case TZ_BLO_IM_FULL:
+        if (!needs_summary()) {
+            TZ_CHECK(refill_blo_im_full());
+            TZ_SUCCEED();
+        }
+        break;
+    case TZ_BLO_DONE:
+        // the output left is the last content screen
+        if ((st->regs.oofs != 0) && !needs_summary()) {
+            TZ_CHECK(refill_blo_done());
+            TZ_SUCCEED();
+        }
+        break;
+    default:
+        break;
+    }
+    global.keys.apdu.sign.u.clear.held_result = true;
+
+    TZ_POSTAMBLE;
+}
+
+/**
+ * @brief Find the last operation checkpointed before the oldest screen
+ * kept, the review can be rewound to.
+ *
+ * @return sign_checkpoint_t *: the checkpoint, NULL if the review
+ *         cannot be rewound
+ */
+static sign_checkpoint_t *
+rewind_checkpoint(void)
+{
+    tz_parser_state   *st = &global.keys.apdu.sign.u.clear.parser_state;
+    sign_checkpoint_t *cp = NULL;
+
+    // only hosts able to send the message again can be asked to, and
+    // only once the part reviewed has been sent again
+    if ((global.step != ST_CLEAR_SIGN) || !global.keys.apdu.sign.restream
+        || TZ_IS_ERR(st->errno)
+        || (global.keys.apdu.sign.step == SIGN_ST_IDLE)
+        || global.keys.apdu.sign.u.clear.rewind_pending
+        || (global.keys.apdu.sign.u.clear.reviewed_length != 0)) {
+        return NULL;
+    }
+
+    int16_t oldest = tz_ui_stream_oldest();
+    size_t  count  = MIN(global.keys.apdu.sign.u.clear.nb_checkpoints,
+                         SIGN_CHECKPOINTS);
+    for (size_t i = 0; i < count; i++) {
+        if ((CHECKPOINTS[i].screen < oldest)
+            && ((cp == NULL) || (CHECKPOINTS[i].screen > cp->screen))) {
+            cp = &CHECKPOINTS[i];
+        }
+    }
+    return cp;
+}
+
+/**
+ * @brief Whether going back from the oldest screen kept would rewind
+ * the review.
+ *
+ * @return bool: whether the review can be rewound
+ */
+static bool
+can_rewind(void)
+{
+    return rewind_checkpoint() != NULL;
+}
+
+/**
+ * @brief Go back to the last operation checkpointed before the oldest
+ * screen kept, when the user goes back past it.
+ *
+ * The host is asked to send the message again from its start, in the
+ * same parts: what comes before the checkpoint is only hashed, and its
+ * hash is checked before the operation is parsed again. The whole part
+ * received before the rewind is checked once sent again.
+ */
+static void
+rewind_review(void)
+{
+    tz_parser_state   *st = &global.keys.apdu.sign.u.clear.parser_state;
+    sign_checkpoint_t *cp = rewind_checkpoint();
+    TZ_PREAMBLE(("void"));
+
+    if (cp == NULL) {
+        TZ_SUCCEED();
+    }
+    PRINTF("[DEBUG] rewind to operation %d, screen %d\n",
+           cp->parser.batch_index, cp->screen);
+
+    TZ_CHECK(hash_received(global.keys.apdu.sign.u.clear.reviewed_hash));
+    CX_CHECK(cx_blake2b_init_no_throw(&global.keys.apdu.hash.state,
+                                      SIGN_HASH_SIZE * 8));
+    global.keys.apdu.sign.u.clear.reviewed_length
+        = global.keys.apdu.sign.u.clear.total_length;
+    global.keys.apdu.sign.u.clear.checked_length = cp->hashed_length;
+    global.keys.apdu.sign.u.clear.rewound        = cp;
+    global.keys.apdu.sign.u.clear.skipped_length = cp->parser.ofs;
+    global.keys.apdu.sign.u.clear.total_length   = 0;
+    global.keys.apdu.sign.received_last_msg      = false;
+
+    tz_operation_parser_restore(st, TZ_UNKNOWN_SIZE, &cp->parser);
+    tz_parser_refill(st, NULL, 0);
+    tz_parser_flush(st, global.line_buf, TZ_UI_STREAM_CONTENTS_SIZE);
+    global.keys.apdu.sign.u.clear.held_result = false;
+    global.keys.apdu.sign.u.clear.nb_checkpoints
+        = cp->parser.batch_index + 1;
+    SCREEN_DISPLAYED = cp->screen_displayed;
+    global.keys.apdu.sign.u.clear.last_field_index = cp->last_field_index;
+    global.keys.apdu.sign.u.clear.displayed_expert_warning
+        = cp->displayed_expert_warning;
+    tz_ui_stream_rewind(cp->screen);
+
+    // the last APDU received waits for its answer while the user reviews
+    if (global.keys.apdu.sign.step == SIGN_ST_WAIT_USER_INPUT) {
+        io_send_sw(SW_RESTREAM);
+    } else {
+        global.keys.apdu.sign.u.clear.rewind_pending = true;
+    }
+    global.keys.apdu.sign.u.clear.received_msg = false;
+    global.keys.apdu.sign.step                 = SIGN_ST_WAIT_DATA;
+
+    TZ_POSTAMBLE;
+}
+#endif
+
 /**
  * @brief Parse until there is nothing left to parse or user input is
  * required.
@@ -449,6 +727,8 @@ pass_from_clear_to_summary(void)
 
     global.step                = ST_SUMMARY_SIGN;
     global.keys.apdu.sign.step = SIGN_ST_WAIT_DATA;
+    // the summary only needs the totals, stop rendering the fields
+    global.keys.apdu.sign.u.clear.parser_state.no_render = true;
 #ifdef HAVE_NBGL
     init_blind_stream();
 #endif
@@ -477,6 +757,9 @@ send_cancel(void)
     case TZ_ERR_TOO_DEEP:
         TZ_FAIL(EXC_PARSE_ERROR);
         break;
+    case TZ_ERR_REJECTED:
+        TZ_FAIL(EXC_REJECT);
+        break;
     default:
         TZ_FAIL(EXC_UNEXPECTED_STATE);
     }
@@ -515,6 +798,8 @@ stream_cb(tz_ui_cb_type_t cb_type)
     case TZ_UI_STREAM_CB_CANCEL:           TZ_CHECK(send_cancel());                break;
 #ifdef HAVE_BAGL
     case TZ_UI_STREAM_CB_BLINDSIGN:        TZ_CHECK(pass_from_clear_to_blind());   break;
+    case TZ_UI_STREAM_CB_PREFETCH:         TZ_CHECK(prefetch());                   break;
+    case TZ_UI_STREAM_CB_REWIND:           TZ_CHECK(rewind_review());              break;
 #else  // HAVE_NBGL
     case TZ_UI_STREAM_CB_BLINDSIGN:
         if (global.step == ST_CLEAR_SIGN) {
@@ -607,6 +892,7 @@ summary_stream_cb(tz_ui_cb_type_t cb_type)
     case TZ_UI_STREAM_CB_ACCEPT: TZ_CHECK(sign_packet());               break;
     case TZ_UI_STREAM_CB_REJECT:  send_reject(EXC_REJECT);              break;
     case TZ_UI_STREAM_CB_REFILL: TZ_CHECK(push_next_summary_screen());  break;
+    case TZ_UI_STREAM_CB_REWIND:                                        break;
     default: TZ_FAIL(EXC_UNKNOWN);
         break;
     }
@@ -622,7 +908,7 @@ init_summary_stream(void)
 {
     TZ_PREAMBLE(("void"));
 #ifdef HAVE_BAGL
-    tz_ui_stream_init(summary_stream_cb);
+    init_stream(summary_stream_cb);
     global.keys.apdu.sign.u.summary.step = SUMMARYSIGN_ST_OPERATION;
     push_next_summary_screen();
     tz_ui_stream();
@@ -645,6 +931,7 @@ pass_to_summary_stream_cb(tz_ui_cb_type_t cb_type)
     switch (cb_type) {
     case TZ_UI_STREAM_CB_VALIDATE: TZ_CHECK(init_summary_stream()); break;
     case TZ_UI_STREAM_CB_REJECT:   send_reject(EXC_REJECT);                break;
+    case TZ_UI_STREAM_CB_REWIND:                                           break;
     default:                       TZ_FAIL(EXC_UNKNOWN);                   break;
     }
     // clang-format on
@@ -655,7 +942,7 @@ pass_to_summary_stream_cb(tz_ui_cb_type_t cb_type)
 static void
 init_too_many_screens_stream(void)
 {
-    tz_ui_stream_init(pass_to_summary_stream_cb);
+    init_stream(pass_to_summary_stream_cb);
 
 #ifdef TARGET_NANOS
     tz_ui_stream_push_warning_not_trusted("Operation too long",
@@ -724,6 +1011,8 @@ bs_stream_cb(tz_ui_cb_type_t cb_type)
         return send_reject(EXC_REJECT);
     case TZ_UI_STREAM_CB_CANCEL:
         return send_cancel();
+    case TZ_UI_STREAM_CB_REWIND:
+        break;
     default: TZ_FAIL(EXC_UNKNOWN);
     }
     // clang-format on
@@ -732,20 +1021,37 @@ bs_stream_cb(tz_ui_cb_type_t cb_type)
 }
 #endif  // HAVE_BAGL
 
-void
-handle_signing_key_setup(buffer_t *cdata, derivation_type_t derivation_type,
-                         bool return_hash)
+/**
+ * @brief Start a new stream for the review: an error ends the signing
+ * session, and the review may be rewound past the oldest screen kept.
+ *
+ * @param cb: the callback of the stream
+ */
+static void
+init_stream(void (*cb)(tz_ui_cb_type_t cb_type))
 {
-    TZ_PREAMBLE(("cdata=%p, derivation_type=%d, return_hash=%d", cdata,
-                 derivation_type, return_hash));
+    tz_ui_stream_init(cb);
+    tz_ui_stream_set_error_hook(close_signing_session);
+#ifdef HAVE_BAGL
+    tz_ui_stream_set_rewind_hook(can_rewind);
+#endif
+}
 
-    TZ_ASSERT_NOTNULL(cdata);
+/**
+ * @brief Initialize the signing state and start the review of a new
+ * message. The signing key must be set up by the caller.
+ *
+ * @param return_hash: whether the hash of the message is requested or not
+ * @param restream: whether the host can send the message again or not
+ */
+static void
+init_signing(bool return_hash, bool restream)
+{
+    TZ_PREAMBLE(("return_hash=%d, restream=%d", return_hash, restream));
 
     memset(&global.keys, 0, sizeof(global.keys));
     global.keys.apdu.sign.return_hash = return_hash;
-
-    TZ_LIB_CHECK(read_bip32_path(&global.path_with_curve.bip32_path, cdata));
-    global.path_with_curve.derivation_type = derivation_type;
+    global.keys.apdu.sign.restream    = restream;
 
     CX_CHECK(cx_blake2b_init_no_throw(&global.keys.apdu.hash.state,
                                       SIGN_HASH_SIZE * 8));
@@ -760,12 +1066,81 @@ handle_signing_key_setup(buffer_t *cdata, derivation_type_t derivation_type,
     TZ_ASSERT(EXC_UNEXPECTED_STATE, (global.step == ST_CLEAR_SIGN)
                                         || (global.step == ST_SWAP_SIGN));
 
-    io_send_sw(SW_OK);
     global.keys.apdu.sign.step = SIGN_ST_WAIT_DATA;
 
     TZ_POSTAMBLE;
 }
 
+void
+handle_signing_key_setup(buffer_t *cdata, derivation_type_t derivation_type,
+                         bool return_hash, bool restream)
+{
+    TZ_PREAMBLE(("cdata=%p, derivation_type=%d, return_hash=%d, restream=%d",
+                 cdata, derivation_type, return_hash, restream));
+
+    TZ_ASSERT_NOTNULL(cdata);
+
+    TZ_LIB_CHECK(read_bip32_path(&global.path_with_curve.bip32_path, cdata));
+    global.path_with_curve.derivation_type = derivation_type;
+
+    TZ_CHECK(init_signing(return_hash, restream));
+
+    io_send_sw(SW_OK);
+
+    TZ_POSTAMBLE;
+}
+
+void
+handle_signing_session_setup(buffer_t         *cdata,
+                             derivation_type_t derivation_type,
+                             bool return_hash, bool restream)
+{
+    TZ_PREAMBLE(("cdata=%p, derivation_type=%d, return_hash=%d, restream=%d",
+                 cdata, derivation_type, return_hash, restream));
+
+    close_signing_session();
+
+    TZ_CHECK(handle_signing_key_setup(cdata, derivation_type, return_hash,
+                                      restream));
+
+    memcpy(&global.sign_session.path_with_curve, &global.path_with_curve,
+           sizeof(global.sign_session.path_with_curve));
+    global.sign_session.active = true;
+
+    TZ_POSTAMBLE;
+}
+
+void
+handle_signing_session_sign(buffer_t         *cdata,
+                            derivation_type_t derivation_type, bool last,
+                            bool return_hash, bool restream)
+{
+    TZ_PREAMBLE(
+        ("cdata=%p, derivation_type=%d, last=%d, return_hash=%d, restream=%d",
+         cdata, derivation_type, last, return_hash, restream));
+
+    TZ_ASSERT_NOTNULL(cdata);
+    TZ_ASSERT(EXC_REFERENCED_DATA_NOT_FOUND, global.sign_session.active);
+    TZ_ASSERT(EXC_WRONG_PARAM,
+              derivation_type
+                  == global.sign_session.path_with_curve.derivation_type);
+
+    memcpy(&global.path_with_curve, &global.sign_session.path_with_curve,
+           sizeof(global.path_with_curve));
+
+    TZ_CHECK(init_signing(return_hash, restream));
+
+    TZ_CHECK(handle_sign(cdata, last, return_hash));
+
+    TZ_POSTAMBLE;
+}
+
+void
+close_signing_session(void)
+{
+    memset(&global.sign_session, 0, sizeof(global.sign_session));
+}
+
 static void
 start_displaying_signature_review(void)
 {
@@ -777,7 +1152,7 @@ start_displaying_signature_review(void)
 #ifdef HAVE_SWAP
     if (!G_called_from_swap) {
 #endif
-        tz_ui_stream_init(stream_cb);
+        init_stream(stream_cb);
         global.step = ST_CLEAR_SIGN;
 
 #ifdef HAVE_BAGL
@@ -796,6 +1171,11 @@ start_displaying_signature_review(void)
     }
 #endif
     tz_operation_parser_init(st, TZ_UNKNOWN_SIZE, false);
+#ifdef HAVE_SWAP
+    // swap only checks the operation, nothing is displayed
+    st->no_render      = G_called_from_swap;
+    st->operation.hook = G_called_from_swap ? swap_check_field : NULL;
+#endif
     tz_parser_refill(st, NULL, 0);
     tz_parser_flush(st, global.line_buf, TZ_UI_STREAM_CONTENTS_SIZE);
 
@@ -806,12 +1186,85 @@ static void
 init_blind_stream(void)
 {
 #ifdef HAVE_BAGL
-    tz_ui_stream_init(bs_stream_cb);
+    init_stream(bs_stream_cb);
 #elif HAVE_NBGL
     nbgl_useCaseSpinner("Loading operation");
 #endif
 }
 
+#ifdef HAVE_BAGL
+/**
+ * @brief Hash the part of the message sent again after a rewind up to
+ * where it is checked, and check it there.
+ *
+ * @param ptr: part of the message, moved past what is hashed
+ * @param size: size of that part, reduced by what is hashed
+ * @param length: part left before the check, reduced by what is hashed
+ * @param expected: hash of the message up to the check
+ */
+static void
+hash_checked(const uint8_t **ptr, size_t *size, size_t *length,
+             const uint8_t expected[SIGN_HASH_SIZE])
+{
+    uint8_t hash[SIGN_HASH_SIZE];
+    size_t  checked = MIN(*size, *length);
+    TZ_PREAMBLE(("length=%u", *length));
+
+    CX_CHECK(cx_hash_no_throw((cx_hash_t *)&global.keys.apdu.hash.state, 0,
+                              *ptr, checked, NULL, 0));
+    *ptr += checked;
+    *size -= checked;
+    *length -= checked;
+    if (*length == 0) {
+        TZ_CHECK(hash_received(hash));
+        TZ_ASSERT(EXC_WRONG_VALUES,
+                  memcmp(hash, expected, SIGN_HASH_SIZE) == 0);
+    }
+
+    TZ_POSTAMBLE;
+}
+#endif
+
+/**
+ * @brief Add a part of the message to its hash.
+ *
+ * After a rewind, the message sent again is checked up to the
+ * checkpoint before it is parsed, and up to where the rewind happened.
+ *
+ * @param cdata: part of the message
+ * @param last: whether the part of the message is the last one or not
+ */
+static void
+hash_data(buffer_t *cdata, bool last)
+{
+    const uint8_t *ptr  = cdata->ptr;
+    size_t         size = cdata->size;
+    TZ_PREAMBLE(("cdata=%p, last=%d", cdata, last));
+
+#ifdef HAVE_BAGL
+    size_t *checked  = &global.keys.apdu.sign.u.clear.checked_length;
+    size_t *reviewed = &global.keys.apdu.sign.u.clear.reviewed_length;
+    if (*checked != 0) {
+        // the checkpoint lies in the part reviewed
+        *reviewed -= MIN(size, *checked);
+        TZ_CHECK(hash_checked(&ptr, &size, checked,
+                              global.keys.apdu.sign.u.clear.rewound->hash));
+    }
+    if (*reviewed != 0) {
+        TZ_CHECK(hash_checked(&ptr, &size, reviewed,
+                              global.keys.apdu.sign.u.clear.reviewed_hash));
+        TZ_ASSERT(EXC_WRONG_VALUES, !last || (*reviewed == 0));
+    }
+#endif
+
+    CX_CHECK(cx_hash_no_throw((cx_hash_t *)&global.keys.apdu.hash.state,
+                              last ? CX_LAST : 0, ptr, size,
+                              global.keys.apdu.hash.final_hash,
+                              sizeof(global.keys.apdu.hash.final_hash)));
+
+    TZ_POSTAMBLE;
+}
+
 void
 handle_sign(buffer_t *cdata, bool last, bool return_hash)
 {
@@ -825,10 +1278,16 @@ handle_sign(buffer_t *cdata, bool last, bool return_hash)
 
     global.keys.apdu.sign.packet_index++;  // XXX drop or check
 
-    CX_CHECK(cx_hash_no_throw((cx_hash_t *)&global.keys.apdu.hash.state,
-                              last ? CX_LAST : 0, cdata->ptr, cdata->size,
-                              global.keys.apdu.hash.final_hash,
-                              sizeof(global.keys.apdu.hash.final_hash)));
+#ifdef HAVE_BAGL
+    if (global.keys.apdu.sign.u.clear.rewind_pending) {
+        // the review was rewound while this part was on its way
+        global.keys.apdu.sign.u.clear.rewind_pending = false;
+        io_send_sw(SW_RESTREAM);
+        TZ_SUCCEED();
+    }
+#endif
+
+    TZ_CHECK(hash_data(cdata, last));
 
     if (last) {
         global.keys.apdu.sign.received_last_msg = true;
@@ -872,8 +1331,20 @@ handle_data_apdu_clear(buffer_t *cdata, bool last)
     global.keys.apdu.sign.u.clear.received_msg = true;
 
     global.keys.apdu.sign.u.clear.total_length += cdata->size;
+    TZ_ASSERT(EXC_WRONG_LENGTH, global.keys.apdu.sign.u.clear.total_length
+                                    < TZ_UNKNOWN_SIZE);
 
-    tz_parser_refill(st, cdata->ptr, cdata->size);
+    size_t skipped = 0;
+#ifdef HAVE_BAGL
+    // after a rewind, the message is parsed again from the checkpoint,
+    // once the part up to it has been checked
+    skipped = MIN(cdata->size, global.keys.apdu.sign.u.clear.skipped_length);
+    global.keys.apdu.sign.u.clear.skipped_length -= skipped;
+    TZ_ASSERT(EXC_WRONG_VALUES,
+              (global.keys.apdu.sign.u.clear.checked_length == 0)
+                  || (skipped == cdata->size));
+#endif
+    tz_parser_refill(st, cdata->ptr + skipped, cdata->size - skipped);
     if (last) {
         tz_operation_parser_set_size(
             st, global.keys.apdu.sign.u.clear.total_length);
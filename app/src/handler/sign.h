@@ -72,6 +72,32 @@ typedef enum {
     SUMMARYSIGN_ST_ACCEPT_REJECT,
 } summarysign_step_t;
 
+#ifdef HAVE_BAGL
+#ifdef TARGET_NANOS
+#define SIGN_CHECKPOINTS 2  /// Operations the review can be rewound to
+#else
+#define SIGN_CHECKPOINTS 4  /// Operations the review can be rewound to
+#endif
+
+/**
+ * @brief Checkpoint taken on the first screen of an operation: the
+ * review can be rewound to it once its screens have been dropped.
+ *
+ * The part of the message received then is checked when sent again,
+ * before the operation is displayed again.
+ *
+ */
+typedef struct {
+    tz_operation_checkpoint parser;                    /// before the tag
+    uint8_t                 hash[SIGN_HASH_SIZE];      /// of the message
+    uint32_t                hashed_length;             /// received then
+    int16_t                 screen;                    /// first screen
+    uint8_t                 screen_displayed;          /// displayed before
+    uint8_t                 last_field_index;          /// of the warning
+    bool                    displayed_expert_warning;  /// warned before
+} sign_checkpoint_t;
+#endif
+
 /**
  * @brief Struct to track state/info about current sign operation.
  *
@@ -81,6 +107,7 @@ typedef struct {
 
     sign_step_t step;  /// Current step of the sign operation.
     bool return_hash;  /// Whether to return the hash of the transaction.
+    bool restream;  /// Whether the host can send the message again.
     bool received_last_msg;  /// Whether the last message has been received.
     uint8_t tag;             /// Type of tezos operation to sign.
 
@@ -91,7 +118,27 @@ typedef struct {
             size_t          total_length;
             uint8_t         last_field_index;
 #ifdef HAVE_BAGL
-            uint8_t screen_displayed;
+            uint8_t  screen_displayed;
+            uint16_t predicted_ops;  /// operations whose screens have
+                                     /// been predicted
+            bool     held_result;    /// the parser result left by the
+                                     /// prefetch awaits the next refill
+            sign_checkpoint_t
+                checkpoints[SIGN_CHECKPOINTS];  /// the first operation,
+                                                /// then the last ones
+            uint16_t nb_checkpoints;   /// operations checkpointed
+            size_t   skipped_length;   /// part of the message sent again
+                                       /// before the checkpoint, not parsed
+            size_t   checked_length;   /// part of the message sent again
+                                       /// up to the checkpoint, checked
+                                       /// before anything is parsed
+            const sign_checkpoint_t
+                *rewound;  /// checkpoint the review was rewound to
+            size_t   reviewed_length;  /// part of the message received
+                                       /// before the rewind, to be checked
+            uint8_t  reviewed_hash[SIGN_HASH_SIZE];  /// hash of that part
+            bool     rewind_pending;  /// the next APDU is answered with
+                                      /// SW_RESTREAM
 #endif
             bool received_msg;
             bool displayed_expert_warning;
@@ -106,6 +153,18 @@ typedef struct {
     } u;
 } apdu_sign_state_t;
 
+/**
+ * @brief Signing session: derivation path reused by successive signing
+ * requests.
+ *
+ * Only the path is kept: the private key is still derived, used and
+ * wiped by the SDK for each signature.
+ */
+typedef struct {
+    bool active;  /// Whether a signing session is open.
+    bip32_path_with_curve_t path_with_curve;  /// Derivation path.
+} sign_session_t;
+
 /**
  * @brief Handle signing key setup request.
  * If successfully parse BIP32 path, set up the key as the signing key,
@@ -114,10 +173,46 @@ typedef struct {
  * @param cdata: data containing the BIP32 path of the key
  * @param derivation_type: derivation_type of the key
  * @param return_hash: whether the hash of the message is requested or not
+ * @param restream: whether the host can send the message again or not
  */
 void handle_signing_key_setup(buffer_t         *cdata,
                               derivation_type_t derivation_type,
-                              bool              return_hash);
+                              bool return_hash, bool restream);
+
+/**
+ * @brief Handle signing session setup request.
+ * Same as `handle_signing_key_setup`, but also keeps the key as the key
+ * of the following session requests.
+ *
+ * @param cdata: data containing the BIP32 path of the key
+ * @param derivation_type: derivation_type of the key
+ * @param return_hash: whether the hash of the message is requested or not
+ * @param restream: whether the host can send the message again or not
+ */
+void handle_signing_session_setup(buffer_t         *cdata,
+                                  derivation_type_t derivation_type,
+                                  bool return_hash, bool restream);
+
+/**
+ * @brief Handle the first APDU of a signature request in a session.
+ * Set up the key of the session as the signing key and handle the
+ * first part of the message, as `handle_sign` would.
+ *
+ * @param cdata: data containing the first part of the message to sign
+ * @param derivation_type: derivation_type of the key, must be the one
+ *        of the session
+ * @param last: whether the part of the message is the last one or not
+ * @param return_hash: whether the hash of the message is requested or not
+ * @param restream: whether the host can send the message again or not
+ */
+void handle_signing_session_sign(buffer_t         *cdata,
+                                 derivation_type_t derivation_type,
+                                 bool last, bool return_hash, bool restream);
+
+/**
+ * @brief Close the signing session, if any.
+ */
+void close_signing_session(void);
 
 /**
  * @brief Handle operation/micheline expression signature request.
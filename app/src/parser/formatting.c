@@ -211,9 +211,21 @@ tz_michelson_op_name(uint8_t op_code)
 static const char tz_b58digits_ordered[]
     = "123456789ABCDEFGHJKLMNPQRSTUVWXYZabcdefghijkmnopqrstuvwxyz";
 
+/// 58^5, the largest power of 58 held in a 32-bit limb with room to
+/// accumulate 32 more bits of input in a 64-bit word
+#define TZ_BASE58_LIMB        656356768u
+#define TZ_BASE58_LIMB_DIGITS 5
+#define TZ_BASE58_MAX_LIMBS                                   \
+    ((TZ_BASE58_BUFFER_SIZE(TZ_BASE58_MAX_INPUT_SIZE)         \
+      + TZ_BASE58_LIMB_DIGITS - 1)                            \
+     / TZ_BASE58_LIMB_DIGITS)
+
 /**
  * @brief Get the base58 format of a number
  *
+ *        The number is converted to base 58^5 limbs, consuming 32 bits
+ *        of input per pass, then each limb is expanded to 5 digits.
+ *
  * @param n: input number
  * @param l: length of the input buffer
  * @param obuf: output buffer
@@ -223,83 +235,182 @@ static const char tz_b58digits_ordered[]
 int
 tz_format_base58(const uint8_t *n, size_t l, char *obuf, size_t olen)
 {
-    int    carry;
-    size_t i, j, high, zcount = 0, obuf_len = TZ_BASE58_BUFFER_SIZE(l);
+    uint32_t limbs[TZ_BASE58_MAX_LIMBS];
+    char     digits[TZ_BASE58_LIMB_DIGITS];
+    size_t   i, j, len, nlimbs = 0, zcount = 0, ndigits = 0;
+    size_t   obuf_len = TZ_BASE58_BUFFER_SIZE(l);
 
-    if (olen < obuf_len) {
+    if ((olen < obuf_len) || (l > TZ_BASE58_MAX_INPUT_SIZE)) {
         PRINTF("[DEBUG] tz_format_base58() called with %u obuf need %u\n",
                olen, obuf_len);
         return 1;
     }
 
-    memset(obuf, 0, obuf_len);
-
     while ((zcount < l) && !n[zcount]) {
         ++zcount;
     }
 
-    for (i = zcount, high = obuf_len - 1; i < l; ++i, high = j) {
-        carry = n[i];
-        for (j = obuf_len - 1; ((int)j >= 0) && ((j > high) || carry); --j) {
-            carry += 256 * obuf[j];
-            obuf[j] = carry % 58;
-            carry /= 58;
+    // limbs are little-endian, the first chunk takes the bytes which
+    // do not fill a full 32-bit word
+    for (i = zcount; i < l;) {
+        size_t   chunk = ((l - i) % 4) ? ((l - i) % 4) : 4;
+        unsigned shift = (unsigned)(8 * chunk);
+        uint64_t carry = 0;
+        for (j = 0; j < chunk; j++, i++) {
+            carry = (carry << 8) | n[i];
+        }
+        for (j = 0; j < nlimbs; j++) {
+            carry += (uint64_t)limbs[j] << shift;
+            limbs[j] = (uint32_t)(carry % TZ_BASE58_LIMB);
+            carry /= TZ_BASE58_LIMB;
+        }
+        while (carry) {
+            limbs[nlimbs++] = (uint32_t)(carry % TZ_BASE58_LIMB);
+            carry /= TZ_BASE58_LIMB;
         }
     }
 
-    if (zcount) {
-        memset(obuf, '1', zcount);
+    // the most significant limb is printed without its leading zeroes
+    if (nlimbs) {
+        for (uint32_t v = limbs[nlimbs - 1]; v; v /= 58) {
+            digits[ndigits++] = tz_b58digits_ordered[v % 58];
+        }
+        len = zcount + ndigits + (TZ_BASE58_LIMB_DIGITS * (nlimbs - 1));
+    } else {
+        len = zcount;
+    }
+    if (len >= olen) {
+        return 1;
     }
 
-    for (j = 0; !obuf[j]; ++j) {
-        // Find the last index of obuf
+    memset(obuf, '1', zcount);
+    obuf += zcount;
+    while (ndigits) {
+        *obuf++ = digits[--ndigits];
     }
-    for (i = 0; j < obuf_len; ++i, ++j) {
-        obuf[i] = tz_b58digits_ordered[(unsigned)obuf[j]];
+    for (i = nlimbs; i > 1; i--) {
+        uint32_t v = limbs[i - 2];
+        for (j = TZ_BASE58_LIMB_DIGITS; j > 0; j--, v /= 58) {
+            obuf[j - 1] = tz_b58digits_ordered[v % 58];
+        }
+        obuf += TZ_BASE58_LIMB_DIGITS;
     }
-    obuf[i] = '\0';
+    *obuf = '\0';
     return 0;
 }
 
+int
+tz_format_u64(uint64_t v, char *obuf, size_t olen)
+{
+    char   digits[TZ_DECIMAL_U64_BUFFER_SIZE - 1];
+    size_t ndigits = 0;
+
+    do {
+        digits[ndigits++] = (char)('0' + (v % 10));
+        v /= 10;
+    } while (v);
+    if (ndigits >= olen) {
+        PRINTF("[DEBUG] tz_format_u64() called with %u obuf need %u\n",
+               olen, ndigits + 1);
+        return 1;
+    }
+    while (ndigits) {
+        *obuf++ = digits[--ndigits];
+    }
+    *obuf = '\0';
+    return 0;
+}
+
+/// 10^9, the largest power of 10 held in a 32-bit limb
+#define TZ_DECIMAL_CHUNK        1000000000u
+#define TZ_DECIMAL_CHUNK_DIGITS 9
+#define TZ_DECIMAL_MAX_LIMBS    ((TZ_DECIMAL_MAX_INPUT_SIZE + 3) / 4)
+#define TZ_DECIMAL_MAX_CHUNKS                          \
+    ((TZ_DECIMAL_BUFFER_SIZE(TZ_DECIMAL_MAX_INPUT_SIZE) \
+      + TZ_DECIMAL_CHUNK_DIGITS - 1)                   \
+     / TZ_DECIMAL_CHUNK_DIGITS)
+
+/**
+ * @brief Get the decimal format of a number
+ *
+ *        Numbers fitting in a 64-bit word (most fees and amounts) are
+ *        given to `tz_format_u64`. Larger ones are split in base 10^9
+ *        chunks by dividing their 32-bit limbs by 10^9, and each chunk
+ *        is then expanded to 9 digits.
+ *
+ * @param n: input number
+ * @param l: length of the input buffer
+ * @param obuf: output buffer
+ * @param olen: length of the output buffer
+ * @return int: 0 on success
+ */
 int
 tz_format_decimal(const uint8_t *n, size_t l, char *obuf, size_t olen)
 {
-    int    carry;
-    size_t i, j, high, zcount = 0, obuf_len = TZ_DECIMAL_BUFFER_SIZE(l);
+    uint32_t chunks[TZ_DECIMAL_MAX_CHUNKS];
+    char     digits[TZ_DECIMAL_CHUNK_DIGITS];
+    size_t   i, j, len, nchunks = 0, ndigits = 0;
+    size_t   obuf_len = TZ_DECIMAL_BUFFER_SIZE(l);
 
-    if (olen < obuf_len) {
-        PRINTF("[DEBUG] tz_format_base58() called with %u obuf need %u\n",
+    if ((olen < obuf_len) || (l > TZ_DECIMAL_MAX_INPUT_SIZE)) {
+        PRINTF("[DEBUG] tz_format_decimal() called with %u obuf need %u\n",
                olen, obuf_len);
         return 1;
     }
 
-    memset(obuf, 0, obuf_len);
-
-    while ((zcount < l) && !n[l - zcount - 1]) {
-        ++zcount;
+    while ((l > 0) && !n[l - 1]) {
+        --l;
     }
 
-    if (zcount == l) {
-        obuf[0] = '0';
-        return 0;
+    if (l <= sizeof(uint64_t)) {
+        uint64_t v = 0;
+        for (i = l; i > 0; i--) {
+            v = (v << 8) | n[i - 1];
+        }
+        return tz_format_u64(v, obuf, olen);
     }
 
-    for (i = zcount, high = obuf_len - 1; i < l; ++i, high = j) {
-        carry = n[l - i - 1];
-        for (j = obuf_len - 1; ((int)j >= 0) && ((j > high) || carry); --j) {
-            carry += 256 * obuf[j];
-            obuf[j] = carry % 10;
-            carry /= 10;
+    uint32_t limbs[TZ_DECIMAL_MAX_LIMBS];
+    size_t   nlimbs = (l + 3) / 4;
+    memset(limbs, 0, sizeof(limbs));
+    for (i = 0; i < l; i++) {
+        limbs[i / 4] |= (uint32_t)n[i] << (8 * (i % 4));
+    }
+    while (nlimbs) {
+        uint64_t rem = 0;
+        for (i = nlimbs; i > 0; i--) {
+            rem          = (rem << 32) | limbs[i - 1];
+            limbs[i - 1] = (uint32_t)(rem / TZ_DECIMAL_CHUNK);
+            rem %= TZ_DECIMAL_CHUNK;
+        }
+        chunks[nchunks++] = (uint32_t)rem;
+        while ((nlimbs > 0) && !limbs[nlimbs - 1]) {
+            --nlimbs;
         }
     }
 
-    for (j = 0; !obuf[j]; ++j) {
-        // Find the last index of obuf
+    // the most significant chunk is printed without its leading zeroes
+    uint32_t v = chunks[nchunks - 1];
+    do {
+        digits[ndigits++] = (char)('0' + (v % 10));
+        v /= 10;
+    } while (v);
+    len = ndigits + (TZ_DECIMAL_CHUNK_DIGITS * (nchunks - 1));
+    if (len >= olen) {
+        return 1;
     }
-    for (i = 0; j < obuf_len; ++i, ++j) {
-        obuf[i] = '0' + obuf[j];
+
+    while (ndigits) {
+        *obuf++ = digits[--ndigits];
+    }
+    for (i = nchunks; i > 1; i--) {
+        v = chunks[i - 2];
+        for (j = TZ_DECIMAL_CHUNK_DIGITS; j > 0; j--, v /= 10) {
+            obuf[j - 1] = (char)('0' + (v % 10));
+        }
+        obuf += TZ_DECIMAL_CHUNK_DIGITS;
     }
-    obuf[i] = '\0';
+    *obuf = '\0';
     return 0;
 }
 
@@ -363,208 +474,195 @@ cx_hash_sha256(uint8_t *data, size_t size, uint8_t *out, size_t size_out)
 }
 #endif
 
+/**
+ * @brief Base58check prefix information
+ */
+typedef struct {
+    const char *name;       /// textual prefix
+    uint8_t     bytes[5];   /// binary prefix
+    uint8_t     len;        /// length of the binary prefix
+    uint8_t     data_len;   /// expected length of the data
+} tz_base58check_prefix;
+
 // clang-format off
-#define B58_PREFIX(_s, _p, _pl, _dl) do {       \
-            if (!strcmp((_s), s)) {             \
-                if ((_dl) != dl) {              \
-                      return 1;                 \
-                }                               \
-                (*p)  = (const uint8_t *)(_p);  \
-                (*pl) = (_pl);                  \
-                return 0;                       \
-            }                                   \
-        } while (0)
+#define B58_PREFIX(_k, _s, _p, _pl, _dl) \
+    [TZ_BASE58CHECK_ ## _k] = { (_s), (_p), (_pl), (_dl) }
 
 /**
- * @brief Get base58 prefix information
- *
- *        To save lines and make things easier to read and modify, we
- *        implement find_prefix() as a series of invocations of the
- *        macro B58_PREFIX().  This macro takes 4 arguments: which
- *        correspond the the arguments of our function directly.  It
- *        matches the textual prefixes and if they do match, it sets
- *        the output parameters and validates that the length is
- *        correct.
- *
- *        find_prefix() returns successfully if it finds a definition
- *        and the length is correct.
- *
- * @param s: prefix we are looking for
- * @param p: an out parameter which is the binary prefix we matched
- * @param pl: another out parameter: the length of the returned binary prefix
- * @param dl: data length which we got
- * @return int: 0 on success
+ * @brief Base58check prefixes, indexed by `tz_base58check_kind`
  */
-static int
-find_prefix(const char *s, const uint8_t **p, size_t *pl, size_t dl)
-{
+static const tz_base58check_prefix tz_base58check_prefixes[] = {
 
     /* For tz_format_hash */
 
-    B58_PREFIX("B",     "\x01\x34",         2, 32);
-    B58_PREFIX("o",     "\x05\x74",         2, 32);
-    B58_PREFIX("expr",  "\x0d\x2c\x40\x1b", 4, 32);
-    B58_PREFIX("proto", "\x02\xaa",         2, 32);
+    B58_PREFIX(BH,     "B",     "\x01\x34",         2, 32),
+    B58_PREFIX(OPH,    "o",     "\x05\x74",         2, 32),
+    B58_PREFIX(EXPR,   "expr",  "\x0d\x2c\x40\x1b", 4, 32),
+    B58_PREFIX(PROTO,  "proto", "\x02\xaa",         2, 32),
 
     /* Public key hashes */
 
-    B58_PREFIX("tz1",  "\x06\xa1\x9f",     3, 20);
-    B58_PREFIX("tz2",  "\x06\xa1\xa1",     3, 20);
-    B58_PREFIX("tz3",  "\x06\xa1\xa4",     3, 20);
-    B58_PREFIX("tz4",  "\x06\xa1\xa6",     3, 20);
+    B58_PREFIX(TZ1,    "tz1",   "\x06\xa1\x9f",     3, 20),
+    B58_PREFIX(TZ2,    "tz2",   "\x06\xa1\xa1",     3, 20),
+    B58_PREFIX(TZ3,    "tz3",   "\x06\xa1\xa4",     3, 20),
+    B58_PREFIX(TZ4,    "tz4",   "\x06\xa1\xa6",     3, 20),
 
     /* Public keys */
 
-    B58_PREFIX("edpk", "\x0d\x0f\x25\xd9", 4, 32);
-    B58_PREFIX("sppk", "\x03\xfe\xe2\x56", 4, 33);
-    B58_PREFIX("p2pk", "\x03\xb2\x8b\x7f", 4, 33);
-    B58_PREFIX("BLpk", "\x06\x95\x87\xcc", 4, 48);
+    B58_PREFIX(EDPK,   "edpk",  "\x0d\x0f\x25\xd9", 4, 32),
+    B58_PREFIX(SPPK,   "sppk",  "\x03\xfe\xe2\x56", 4, 33),
+    B58_PREFIX(P2PK,   "p2pk",  "\x03\xb2\x8b\x7f", 4, 33),
+    B58_PREFIX(BLPK,   "BLpk",  "\x06\x95\x87\xcc", 4, 48),
 
     /* Signatures */
 
-    B58_PREFIX("sig", "\x04\x82\x2b", 3, 64);
-    B58_PREFIX("edsig", "\x09\xf5\xcd\x86\x12", 5, 64);
-    B58_PREFIX("spsig1", "\x0d\x73\x65\x13\x3f", 5, 64);
-    B58_PREFIX("p2sig", "\x36\xf0\x2c\x34", 4, 64);
-    B58_PREFIX("BLsig", "\x28\xab\x40\xcf", 4, 96);
+    B58_PREFIX(SIG,    "sig",    "\x04\x82\x2b",         3, 64),
+    B58_PREFIX(EDSIG,  "edsig",  "\x09\xf5\xcd\x86\x12", 5, 64),
+    B58_PREFIX(SPSIG1, "spsig1", "\x0d\x73\x65\x13\x3f", 5, 64),
+    B58_PREFIX(P2SIG,  "p2sig",  "\x36\xf0\x2c\x34",     4, 64),
+    B58_PREFIX(BLSIG,  "BLsig",  "\x28\xab\x40\xcf",     4, 96),
 
     /* For tz_format_address */
 
-    B58_PREFIX("KT1",  "\x02\x5a\x79",     3, 20);
-    B58_PREFIX("txr1", "\x01\x80\x78\x1f", 4, 20);
-    B58_PREFIX("zkr1", "\x01\xab\x54\xfb", 4, 20);
+    B58_PREFIX(KT1,    "KT1",   "\x02\x5a\x79",     3, 20),
+    B58_PREFIX(TXR1,   "txr1",  "\x01\x80\x78\x1f", 4, 20),
+    B58_PREFIX(ZKR1,   "zkr1",  "\x01\xab\x54\xfb", 4, 20),
 
     /* Smart rollup hashes */
 
-    B58_PREFIX("sr1",  "\x06\x7c\x75",     3, 20);
+    B58_PREFIX(SR1,    "sr1",   "\x06\x7c\x75",     3, 20),
 
     /* Smart rollup commitment hashes */
 
-    B58_PREFIX("src1", "\x11\xa5\x86\x8a", 4, 32);
-
-    return 1;
-}
+    B58_PREFIX(SRC1,   "src1",  "\x11\xa5\x86\x8a", 4, 32),
+};
 // clang-format on
 
 int
-tz_format_base58check(const char *sprefix, const uint8_t *data, size_t size,
-                      char *obuf, size_t olen)
+tz_format_base58check_kind(tz_base58check_kind kind, const uint8_t *data,
+                           size_t size, char *obuf, size_t olen)
 {
-    const uint8_t *prefix = NULL;
-    size_t         prefix_len;
+    if (kind >= TZ_BASE58CHECK_KIND_COUNT) {
+        return 1;
+    }
+
+    const tz_base58check_prefix *prefix = &tz_base58check_prefixes[kind];
 
-    if (find_prefix(sprefix, &prefix, &prefix_len, size)) {
+    if (prefix->data_len != size) {
         return 1;
     }
+    if (obuf == NULL) {
+        return 0;
+    }
 
     /* In order to avoid vla, we have a maximum buffer size of 128 */
     uint8_t prepared[128];
-    if ((prefix_len + size + 4) > sizeof(prepared)) {
+    if ((prefix->len + size + 4) > sizeof(prepared)) {
         PRINTF(
             "[WARNING] tz_format_base58check() failed: fixed size "
             "array is too small need: %u\n",
-            prefix_len + size + 4);
+            prefix->len + size + 4);
         return 1;
     }
 
-    memcpy(prepared, prefix, prefix_len);
-    memcpy(prepared + prefix_len, data, size);
+    memcpy(prepared, prefix->bytes, prefix->len);
+    memcpy(prepared + prefix->len, data, size);
     uint8_t tmp[32];
-    cx_hash_sha256(prepared, size + prefix_len, tmp, 32);
+    cx_hash_sha256(prepared, size + prefix->len, tmp, 32);
     cx_hash_sha256(tmp, 32, tmp, 32);
-    memcpy(prepared + size + prefix_len, tmp, 4);
-    return tz_format_base58(prepared, prefix_len + size + 4, obuf, olen);
+    memcpy(prepared + size + prefix->len, tmp, 4);
+    return tz_format_base58(prepared, prefix->len + size + 4, obuf, olen);
 }
 
 int
-tz_format_pkh(const uint8_t *data, size_t size, char *obuf, size_t olen)
+tz_format_base58check(const char *sprefix, const uint8_t *data, size_t size,
+                      char *obuf, size_t olen)
 {
-    const char *prefix;
+    for (int kind = 0; kind < TZ_BASE58CHECK_KIND_COUNT; kind++) {
+        if (!strcmp((const char *)PIC(tz_base58check_prefixes[kind].name),
+                    sprefix)) {
+            return tz_format_base58check_kind((tz_base58check_kind)kind, data,
+                                              size, obuf, olen);
+        }
+    }
+    return 1;
+}
 
-    if (size < 1) {
+int
+tz_format_pkh(const uint8_t *data, size_t size, char *obuf, size_t olen)
+{
+    if ((size < 1) || (data[0] > 3)) {
         return 1;
     }
-    // clang-format off
-    switch (data[0]) {
-    case 0:  prefix = "tz1"; break;
-    case 1:  prefix = "tz2"; break;
-    case 2:  prefix = "tz3"; break;
-    case 3:  prefix = "tz4"; break;
-    default: return 1;
-    }
-    // clang-format on
-
-    return tz_format_base58check(prefix, data + 1, size - 1, obuf, olen);
+    // tags 0 to 3 are tz1 to tz4
+    return tz_format_base58check_kind(TZ_BASE58CHECK_TZ1 + data[0], data + 1,
+                                      size - 1, obuf, olen);
 }
 
 int
 tz_format_pk(const uint8_t *data, size_t size, char *obuf, size_t olen)
 {
-    const char *prefix;
-
-    if (size < 1) {
+    if ((size < 1) || (data[0] > 3)) {
         return 1;
     }
-    // clang-format off
-    switch (data[0]) {
-    case 0:  prefix = "edpk"; break;
-    case 1:  prefix = "sppk"; break;
-    case 2:  prefix = "p2pk"; break;
-    case 3:  prefix = "BLpk"; break;
-    default: return 1;
-    }
-    // clang-format on
-
-    return tz_format_base58check(prefix, data + 1, size - 1, obuf, olen);
+    // tags 0 to 3 are edpk, sppk, p2pk and BLpk
+    return tz_format_base58check_kind(TZ_BASE58CHECK_EDPK + data[0],
+                                      data + 1, size - 1, obuf, olen);
 }
 
 int
 tz_format_sig(const uint8_t *data, size_t size, char *obuf, size_t olen)
 {
-    const char *prefix;
+    tz_base58check_kind kind;
 
     // clang-format off
     switch (size) {
-    case 64:  prefix = "sig"; break;
-    case 96:  prefix = "BLsig"; break;
+    case 64:  kind = TZ_BASE58CHECK_SIG; break;
+    case 96:  kind = TZ_BASE58CHECK_BLSIG; break;
     default: return 1;
     }
     // clang-format on
 
-    return tz_format_base58check(prefix, data, size, obuf, olen);
+    return tz_format_base58check_kind(kind, data, size, obuf, olen);
 }
 
 int
 tz_format_oph(const uint8_t *data, size_t size, char *obuf, size_t olen)
 {
-    return tz_format_base58check("o", data, size, obuf, olen);
+    return tz_format_base58check_kind(TZ_BASE58CHECK_OPH, data, size, obuf,
+                                      olen);
 }
 
 int
 tz_format_bh(const uint8_t *data, size_t size, char *obuf, size_t olen)
 {
-    return tz_format_base58check("B", data, size, obuf, olen);
+    return tz_format_base58check_kind(TZ_BASE58CHECK_BH, data, size, obuf,
+                                      olen);
 }
 
+/**
+ * @brief Base58check kinds of the originated addresses, indexed by tag
+ */
+static const tz_base58check_kind tz_address_kinds[] = {
+    [1] = TZ_BASE58CHECK_KT1,
+    [2] = TZ_BASE58CHECK_TXR1,
+    [3] = TZ_BASE58CHECK_SR1,
+    [4] = TZ_BASE58CHECK_ZKR1,
+};
+
 int
 tz_format_address(const uint8_t *data, size_t size, char *obuf, size_t olen)
 {
-    const char *prefix;
-
     if (size < 1) {
         return 1;
     }
-    // clang-format off
-    switch (data[0]) {
-    case 1:  prefix = "KT1";  break;
-    case 2:  prefix = "txr1"; break;
-    case 3:  prefix = "scr1"; break;
-    case 4:  prefix = "zkr1"; break;
-
-    case 0:  return tz_format_pkh(data+1, size-1, obuf, olen);
-    default: return 1;
+    if (data[0] == 0) {
+        return tz_format_pkh(data + 1, size - 1, obuf, olen);
     }
-    // clang-format on
-
-    return tz_format_base58check(prefix, data + 1, size - 2, obuf, olen);
+    if (data[0] >= (sizeof(tz_address_kinds) / sizeof(tz_address_kinds[0]))) {
+        return 1;
+    }
+    // originated addresses end with a padding byte
+    return tz_format_base58check_kind(tz_address_kinds[data[0]], data + 1,
+                                      size - 2, obuf, olen);
 }
@@ -210,12 +210,17 @@ typedef enum {
 
 #define TZ_DECIMAL_BUFFER_SIZE(_l) ((((_l)*241) / 100) + 1)
 
+/// Maximum length of the numbers formatted by `tz_format_decimal`
+#define TZ_DECIMAL_MAX_INPUT_SIZE 32
+
 /**
  * @brief Formats a positive number of arbitrary to decimal.
  *
  *        The number is stored in little-endian order in the first `l`
  *        bytes of `n`. The output buffer `obuf` must be at least
- *        `TZ_DECIMAL_BUFFER_SIZE(l)` (caller responsibility).
+ *        `TZ_DECIMAL_BUFFER_SIZE(l)` (caller responsibility), plus
+ *        one for the null terminator of the largest numbers. `l`
+ *        must be at most `TZ_DECIMAL_MAX_INPUT_SIZE`.
  *
  * @param n: input number
  * @param l: length of the input number
@@ -225,14 +230,31 @@ typedef enum {
  */
 int tz_format_decimal(const uint8_t *n, size_t l, char *obuf, size_t olen);
 
+/// Size of the decimal format of a 64-bit number, null terminator included
+#define TZ_DECIMAL_U64_BUFFER_SIZE 21
+
+/**
+ * @brief Formats a 64-bit unsigned number to decimal.
+ *
+ * @param v: input number
+ * @param obuf: output buffer
+ * @param olen: length of the output buffer
+ * @return int: 0 on success
+ */
+int tz_format_u64(uint64_t v, char *obuf, size_t olen);
+
 #define TZ_BASE58_BUFFER_SIZE(_l) ((((_l)*138) / 100) + 1)
 
+/// Maximum length of the data formatted by `tz_format_base58`
+#define TZ_BASE58_MAX_INPUT_SIZE 128
+
 /**
  * @brief Formats a data `n` of size `l` in base58 using Tezos'
  *        alphabet order (same as Bitcoin).
  *
  *        The output buffer `obuf` must be at least
- *        `BASE58_BUFFER_SIZE(l)` (caller responsibility).
+ *        `BASE58_BUFFER_SIZE(l)` (caller responsibility). `l` must
+ *        be at most `TZ_BASE58_MAX_INPUT_SIZE`.
  *
  * @param n: input data
  * @param l: length of the input data
@@ -245,18 +267,67 @@ int tz_format_base58(const uint8_t *n, size_t l, char *obuf, size_t olen);
 #define TZ_BASE58CHECK_BUFFER_SIZE(_l, _p) \
     TZ_BASE58_BUFFER_SIZE(((_p) + (_l)) + 4)
 
+/**
+ * @brief Kinds of base58check encoded data, named after their prefix
+ */
+typedef enum {
+    TZ_BASE58CHECK_BH,      /// block hash, B(51)
+    TZ_BASE58CHECK_OPH,     /// operation hash, o(51)
+    TZ_BASE58CHECK_EXPR,    /// script expression hash, expr(54)
+    TZ_BASE58CHECK_PROTO,   /// protocol hash, P(51)
+    TZ_BASE58CHECK_TZ1,     /// ed25519 public key hash, tz1(36)
+    TZ_BASE58CHECK_TZ2,     /// secp256k1 public key hash, tz2(36)
+    TZ_BASE58CHECK_TZ3,     /// p256 public key hash, tz3(36)
+    TZ_BASE58CHECK_TZ4,     /// bls12_381 public key hash, tz4(36)
+    TZ_BASE58CHECK_EDPK,    /// ed25519 public key, edpk(54)
+    TZ_BASE58CHECK_SPPK,    /// secp256k1 public key, sppk(55)
+    TZ_BASE58CHECK_P2PK,    /// p256 public key, p2pk(55)
+    TZ_BASE58CHECK_BLPK,    /// bls12_381 public key, BLpk(76)
+    TZ_BASE58CHECK_SIG,     /// generic signature, sig(96)
+    TZ_BASE58CHECK_EDSIG,   /// ed25519 signature, edsig(99)
+    TZ_BASE58CHECK_SPSIG1,  /// secp256k1 signature, spsig1(99)
+    TZ_BASE58CHECK_P2SIG,   /// p256 signature, p2sig(98)
+    TZ_BASE58CHECK_BLSIG,   /// bls12_381 signature, BLsig(142)
+    TZ_BASE58CHECK_KT1,     /// originated contract hash, KT1(36)
+    TZ_BASE58CHECK_TXR1,    /// transaction rollup hash, txr1(37)
+    TZ_BASE58CHECK_ZKR1,    /// zk rollup hash, zkr1(37)
+    TZ_BASE58CHECK_SR1,     /// smart rollup hash, sr1(36)
+    TZ_BASE58CHECK_SRC1,    /// smart rollup commitment hash, src1(54)
+    TZ_BASE58CHECK_KIND_COUNT
+} tz_base58check_kind;
+
+/**
+ * @brief Formats data of a given kind in base58check
+ *
+ *        The binary prefix and the expected data length are directly
+ *        read from a table indexed by `kind`. Will return an error if
+ *        the lengths do not match. Then it will add the prefix, append
+ *        the four first bytes of a double-sha256 of this
+ *        concatenation, and call `format_base58`.
+ *
+ *        With a NULL `obuf`, only checks that the data can be
+ *        formatted.
+ *
+ * @param kind: kind of the data
+ * @param ibuf: input buffer
+ * @param ilen: length of the input buffer
+ * @param obuf: output buffer, can be NULL
+ * @param olen: length of the output buffer
+ * @return int: 0 on success
+ */
+int tz_format_base58check_kind(tz_base58check_kind kind, const uint8_t *ibuf,
+                               size_t ilen, char *obuf, size_t olen);
+
 /**
  * @brief Looks up the prefix from the provided string (arg1),
  *        e.g. "B", "o", "expr", "tz2", etc.
  *
- *        This indexes into a table which finds the appropriate binary
- *        prefix and the data length which is required. Will return an
- *        error if the lengths do not match.  Then it will add the
- *        provided prefix, append the four first bytes of a
- *        double-sha256 of this concatenation, and call
- *        `format_base58`. The output buffer `obuf` must be at least
+ *        This searches the table of `tz_format_base58check_kind` for
+ *        the provided prefix, and formats the data with the kind
+ *        found. The output buffer `obuf` must be at least
  *        `TZ_BASE58CHECK_BUFFER_SIZE(l, prefix_len)` (caller
- *        responsibility).
+ *        responsibility). Prefer `tz_format_base58check_kind` when
+ *        the kind is known statically.
  *
  * @param prefix: base58 prefix
  * @param ibuf: input buffer
@@ -272,7 +343,8 @@ int tz_format_base58check(const char *prefix, const uint8_t *ibuf,
  * Some Tezos-specific base58check formatters. These functions
  * deconstruct the Tezos binary header to figure out the kind within
  * the type (e.g. the curve for keys), check the length, and feed the
- * appropriate prefix to `format_base58check`. These function need to
+ * appropriate kind to `tz_format_base58check_kind`, so they only check
+ * the data when given a NULL output buffer. These function need to
  * be updated when new formats are added via a Tezos protocol upgrade.
  */
 
@@ -304,7 +376,8 @@ int tz_format_pkh(const uint8_t *ibuf, size_t ilen, char *obuf, size_t olen);
  * @param olen: length of the output buffer
  * @return int: 0 on success
  *
- * @deprecated Use tz_format_base58check("o", ...) instead
+ * @deprecated Use tz_format_base58check_kind(TZ_BASE58CHECK_OPH, ...)
+ *             instead
  */
 int tz_format_oph(const uint8_t *ibuf, size_t ilen, char *obuf, size_t olen);
 
@@ -319,7 +392,8 @@ int tz_format_oph(const uint8_t *ibuf, size_t ilen, char *obuf, size_t olen);
  * @param olen: length of the output buffer
  * @return int: 0 on success
  *
- * @deprecated Use tz_format_base58check("B", ...) instead
+ * @deprecated Use tz_format_base58check_kind(TZ_BASE58CHECK_BH, ...)
+ *             instead
  */
 int tz_format_bh(const uint8_t *ibuf, size_t ilen, char *obuf, size_t olen);
 
@@ -330,7 +404,7 @@ int tz_format_bh(const uint8_t *ibuf, size_t ilen, char *obuf, size_t olen);
  *        tag 0: tag(1) + pkh(20) (tz1, tz2, tz3, tz4, see format_pkh)
  *        tag 1: txrolluph(20) + padding(1), KT1(36)
  *        tag 2: txrolluph(20) + padding(1), txr1(36)
- *        tag 3: rolluph(20) + padding(1), scr1(36)
+ *        tag 3: rolluph(20) + padding(1), sr1(36)
  *        tag 4: zkrolluph(20) + padding(1), zkr1(36)
  *
  * @param ibuf: input buffer
@@ -30,24 +30,52 @@ static tz_parser_result pop_frame(tz_parser_state *state);
 static tz_parser_result begin_sized(tz_parser_state *state);
 static tz_parser_result print_escaped(tz_parser_state *state, uint8_t b);
 static tz_parser_result parser_put(tz_parser_state *state, char c);
+static tz_parser_result parser_put_span(tz_parser_state *state,
+                                        const char *str, size_t *written);
 static tz_parser_result tag_selection(tz_parser_state *state, uint8_t t);
 
-#ifdef TEZOS_DEBUG
+#if defined(TEZOS_DEBUG) || defined(TZ_PARSER_COUNTERS)
 const char *const tz_micheline_parser_step_name[]
-    = {"TAG",   "PRIM_OP", "PRIM_NAME", "PRIM", "SIZE",      "SEQ",
-       "BYTES", "STRING",  "ANNOT",     "INT",  "PRINT_INT", "CONTINUE"};
+    = {"TAG",   "PRIM_OP", "PRIM_NAME", "PRIM",
+       "SIZE",  "SEQ",     "BYTES",     "STRING",
+       "ANNOT", "INT",     "PRINT_INT", "PRINT_CAPTURE",
+       "COMB"};
 #endif
 
+/// Read and write the fields of a frame
+#define FRAME_GET(frame, field) TZ_MICHELINE_FRAME_GET(frame, field)
+#define FRAME_SET(frame, field, value) \
+    TZ_MICHELINE_FRAME_SET(frame, field, value)
+
 const char hex_c[] = "0123456789ABCDEF";
 
+/// Hexadecimal encoding of every byte, two characters per byte
+static const char hex_pairs[]
+    = "000102030405060708090A0B0C0D0E0F"
+      "101112131415161718191A1B1C1D1E1F"
+      "202122232425262728292A2B2C2D2E2F"
+      "303132333435363738393A3B3C3D3E3F"
+      "404142434445464748494A4B4C4D4E4F"
+      "505152535455565758595A5B5C5D5E5F"
+      "606162636465666768696A6B6C6D6E6F"
+      "707172737475767778797A7B7C7D7E7F"
+      "808182838485868788898A8B8C8D8E8F"
+      "909192939495969798999A9B9C9D9E9F"
+      "A0A1A2A3A4A5A6A7A8A9AAABACADAEAF"
+      "B0B1B2B3B4B5B6B7B8B9BABBBCBDBEBF"
+      "C0C1C2C3C4C5C6C7C8C9CACBCCCDCECF"
+      "D0D1D2D3D4D5D6D7D8D9DADBDCDDDEDF"
+      "E0E1E2E3E4E5E6E7E8E9EAEBECEDEEEF"
+      "F0F1F2F3F4F5F6F7F8F9FAFBFCFDFEFF";
+
 void
 tz_micheline_parser_init(tz_parser_state *state)
 {
     tz_micheline_state *m = &state->micheline;
 
-    m->frame         = m->stack;
-    m->stack[0].step = TZ_MICHELINE_STEP_TAG;
-    m->is_unit       = false;
+    m->frame   = m->stack;
+    m->is_unit = false;
+    FRAME_SET(&m->stack[0], STEP, TZ_MICHELINE_STEP_TAG);
 }
 
 /**
@@ -66,7 +94,7 @@ push_frame(tz_parser_state *state, tz_micheline_parser_step_kind step)
         tz_raise(TOO_DEEP);
     }
     m->frame++;
-    m->frame->step = step;
+    FRAME_SET(m->frame, STEP, step);
     tz_continue;
 }
 
@@ -103,42 +131,165 @@ begin_sized(tz_parser_state *state)
     if (push_frame(state, TZ_MICHELINE_STEP_SIZE)) {
         tz_reraise;
     }
-    m->frame->step_size.size = 0;
-    m->frame->stop           = state->ofs + 4;
+    if ((uint32_t)state->ofs > (TZ_MAX_OFFSET - 4)) {
+        tz_raise(TOO_LARGE);
+    }
+    m->leaf.size = 0;
+    FRAME_SET(m->frame, STOP, (uint32_t)state->ofs + 4);
     tz_continue;
 }
 
 /**
- * @brief Ask to print an escape character
+ * @brief Escape a character of a string
  *
- * @param state: parser state
- * @param b: escape character
- * @return tz_parser_result: parser result
+ * @param b: character to escape
+ * @param buf: output, at least 4 bytes
+ * @return size_t: length of the escape sequence
  */
-static tz_parser_result
-print_escaped(tz_parser_state *state, uint8_t b)
+static size_t
+escape_char(uint8_t b, char *buf)
 {
-    char *buf = (char *)state->buffers.capture;
-    tz_must(push_frame(state, TZ_MICHELINE_STEP_PRINT_CAPTURE));
-    state->micheline.frame->step_capture.ofs = 0;
     // clang-format off
     switch (b) {
-    case '\\': strncpy(buf,"\\\\",TZ_CAPTURE_BUFFER_SIZE); break;
-    case '"':  strncpy(buf,"\\\"",TZ_CAPTURE_BUFFER_SIZE); break;
-    case '\r': strncpy(buf,"\\r",TZ_CAPTURE_BUFFER_SIZE);  break;
-    case '\n': strncpy(buf,"\\n",TZ_CAPTURE_BUFFER_SIZE);  break;
-    case '\t': strncpy(buf,"\\t",TZ_CAPTURE_BUFFER_SIZE);  break;
+    case '\\': buf[0] = '\\'; buf[1] = '\\'; break;
+    case '"':  buf[0] = '\\'; buf[1] = '"';  break;
+    case '\r': buf[0] = '\\'; buf[1] = 'r';  break;
+    case '\n': buf[0] = '\\'; buf[1] = 'n';  break;
+    case '\t': buf[0] = '\\'; buf[1] = 't';  break;
     default:
         buf[0] = '0' + (b/100);
         buf[1] = '0' + ((b/10)%10);
         buf[2] = '0' + (b%10);
         buf[3] = 0;
-        break;
+        return 3;
     }
     // clang-format on
+    buf[2] = 0;
+    return 2;
+}
+
+/**
+ * @brief Ask to print an escape character
+ *
+ * @param state: parser state
+ * @param b: escape character
+ * @return tz_parser_result: parser result
+ */
+static tz_parser_result
+print_escaped(tz_parser_state *state, uint8_t b)
+{
+    tz_must(push_frame(state, TZ_MICHELINE_STEP_PRINT_CAPTURE));
+    state->micheline.leaf.ofs = 0;
+    escape_char(b, (char *)state->buffers.capture);
     tz_continue;
 }
 
+/**
+ * @brief Number of bytes of the current sized node available in the
+ *        input buffer
+ *
+ * @param state: parser state
+ * @return size_t: number of bytes
+ */
+static size_t
+available_input(tz_parser_state *state)
+{
+    size_t left = (size_t)(FRAME_GET(state->micheline.frame, STOP)
+                           - (uint32_t)state->ofs);
+    return MIN(left, state->regs.ilen);
+}
+
+/**
+ * @brief Consume bytes of the input buffer
+ *
+ * @param state: parser state
+ * @param n: number of bytes, at most `regs.ilen`
+ */
+static void
+consume_input(tz_parser_state *state, size_t n)
+{
+    state->regs.iofs += n;
+    state->regs.ilen -= n;
+    state->ofs += (int)n;
+}
+
+/**
+ * @brief Print the characters of a string, escaping them, as long as
+ *        both the input and the output buffers allow
+ *
+ *        Stops before a character whose escape sequence does not fit
+ *        in the output buffer. When not rendering, only consumes the
+ *        input.
+ *
+ * @param state: parser state
+ * @return size_t: number of input bytes consumed
+ */
+static size_t
+print_string_span(tz_parser_state *state)
+{
+    tz_parser_regs *regs = &state->regs;
+    const uint8_t  *in   = regs->ibuf + regs->iofs;
+    size_t          n    = available_input(state);
+    size_t          i;
+
+    if (state->no_render) {
+        consume_input(state, n);
+        return n;
+    }
+    for (i = 0; (i < n) && (regs->olen > 0); i++) {
+        uint8_t b = in[i];
+        if ((b >= 0x20) && (b < 0x80) && (b != '\"') && (b != '\\')) {
+            regs->obuf[regs->oofs] = (char)b;
+            regs->oofs++;
+            regs->olen--;
+        } else {
+            char   esc[4];
+            size_t len = escape_char(b, esc);
+            if (len > regs->olen) {
+                break;
+            }
+            memcpy(regs->obuf + regs->oofs, esc, len);
+            regs->oofs += len;
+            regs->olen -= len;
+        }
+    }
+    consume_input(state, i);
+    return i;
+}
+
+/**
+ * @brief Print the hexadecimal encoding of bytes, as long as both the
+ *        input and the output buffers allow
+ *
+ *        Only whole bytes are printed: stops when a single character
+ *        is left in the output buffer. When not rendering, only
+ *        consumes the input.
+ *
+ * @param state: parser state
+ * @return size_t: number of input bytes consumed
+ */
+static size_t
+print_bytes_span(tz_parser_state *state)
+{
+    tz_parser_regs *regs = &state->regs;
+    const uint8_t  *in   = regs->ibuf + regs->iofs;
+    size_t          n    = MIN(available_input(state), regs->olen / 2);
+
+    if (state->no_render) {
+        n = available_input(state);
+        consume_input(state, n);
+        return n;
+    }
+    for (size_t i = 0; i < n; i++) {
+        regs->obuf[regs->oofs]     = hex_pairs[2 * in[i]];
+        regs->obuf[regs->oofs + 1] = hex_pairs[(2 * in[i]) + 1];
+        regs->oofs += 2;
+    }
+    regs->olen -= 2 * n;
+    consume_input(state, n);
+    return n;
+}
+
 /**
  * @brief Print a character
  *
@@ -150,9 +301,48 @@ static tz_parser_result
 parser_put(tz_parser_state *state, char c)
 {
     PRINTF("[DEBUG] put(char: '%c',int: %d)\n", c, (int)c);
+    if (state->no_render) {
+        tz_continue;
+    }
     return tz_parser_put(state, c);
 }
 
+/**
+ * @brief Print as much of a string as possible
+ *
+ *        The number of characters printed is stored in `written` even
+ *        if the output gets full, so that the caller can resume. When
+ *        not rendering, the whole string counts as printed.
+ *
+ * @param state: parser state
+ * @param str: string
+ * @param written: number of characters printed
+ * @return tz_parser_result: parser result
+ */
+static tz_parser_result
+parser_put_span(tz_parser_state *state, const char *str, size_t *written)
+{
+    PRINTF("[DEBUG] put_span(str: \"%s\")\n", str);
+    if (state->no_render) {
+        *written = strlen(str);
+        tz_continue;
+    }
+    return tz_parser_put_span(state, str, written);
+}
+
+/**
+ * @brief Check if a frame reads the arguments of a prim
+ *
+ * @param frame: frame
+ * @return bool: whether the frame is a prim frame reading arguments
+ */
+static bool
+reads_prim_args(const tz_micheline_parser_frame *frame)
+{
+    return (FRAME_GET(frame, STEP) == TZ_MICHELINE_STEP_PRIM)
+           || (FRAME_GET(frame, STEP) == TZ_MICHELINE_STEP_COMB);
+}
+
 /**
  * @brief Plan the steps required to read the micheline value
  *        associated to the micheline tag
@@ -171,26 +361,27 @@ tag_selection(tz_parser_state *state, uint8_t t)
 
     switch (t) {
     case TZ_MICHELINE_TAG_INT:
-        m->frame->step = TZ_MICHELINE_STEP_INT;
-        tz_parse_num_state_init(&state->buffers.num, &m->frame->step_int);
+        FRAME_SET(m->frame, STEP, TZ_MICHELINE_STEP_INT);
+        tz_parse_num_state_init(&state->buffers.num, &m->leaf.num);
+        m->leaf.num.skip_decimal = state->no_render;
         for (int i = 0; i < (TZ_NUM_BUFFER_SIZE / 8); i++) {
             state->buffers.num.bytes[i] = 0;
         }
         break;
     case TZ_MICHELINE_TAG_SEQ:
-        m->frame->step           = TZ_MICHELINE_STEP_SEQ;
-        m->frame->step_seq.first = true;
+        FRAME_SET(m->frame, STEP, TZ_MICHELINE_STEP_SEQ);
+        FRAME_SET(m->frame, FIRST, true);
         tz_must(begin_sized(state));
         break;
     case TZ_MICHELINE_TAG_BYTES:
-        m->frame->step                    = TZ_MICHELINE_STEP_BYTES;
-        m->frame->step_bytes.first        = true;
-        m->frame->step_bytes.has_rem_half = false;
+        FRAME_SET(m->frame, STEP, TZ_MICHELINE_STEP_BYTES);
+        FRAME_SET(m->frame, FIRST, true);
+        FRAME_SET(m->frame, HAS_REM_HALF, false);
         tz_must(begin_sized(state));
         break;
     case TZ_MICHELINE_TAG_STRING:
-        m->frame->step              = TZ_MICHELINE_STEP_STRING;
-        m->frame->step_string.first = true;
+        FRAME_SET(m->frame, STEP, TZ_MICHELINE_STEP_STRING);
+        FRAME_SET(m->frame, FIRST, true);
         tz_must(begin_sized(state));
         break;
     case TZ_MICHELINE_TAG_PRIM_0_ANNOTS:
@@ -202,22 +393,18 @@ tag_selection(tz_parser_state *state, uint8_t t)
         nargs = (t - 3) >> 1;
         annot = (~t & 1);
         wrap  = (m->frame > m->stack)
-               && (m->frame[-1].step == TZ_MICHELINE_STEP_PRIM)
+               && reads_prim_args(&m->frame[-1])
                && ((nargs > 0) || annot);
         goto common_prim;
     case TZ_MICHELINE_TAG_PRIM_N:
-        wrap = (m->frame > m->stack)
-               && (m->frame[-1].step == TZ_MICHELINE_STEP_PRIM);
+        wrap  = (m->frame > m->stack) && reads_prim_args(&m->frame[-1]);
         nargs = 3;
         annot = true;
     common_prim:
-        m->frame->step            = TZ_MICHELINE_STEP_PRIM_OP;
-        m->frame->step_prim.ofs   = 0;
-        m->frame->step_prim.nargs = nargs;
-        m->frame->step_prim.wrap  = wrap;
-        m->frame->step_prim.spc   = false;
-        m->frame->step_prim.first = true;
-        m->frame->step_prim.annot = annot;
+        FRAME_SET(m->frame, STEP, TZ_MICHELINE_STEP_PRIM_OP);
+        FRAME_SET(m->frame, NARGS, nargs);
+        FRAME_SET(m->frame, WRAP, wrap);
+        FRAME_SET(m->frame, ANNOT, annot);
         break;
     default:
         tz_raise(INVALID_TAG);
@@ -225,10 +412,18 @@ tag_selection(tz_parser_state *state, uint8_t t)
     tz_continue;
 }
 
-tz_parser_result
-tz_micheline_parser_step(tz_parser_state *state)
+/**
+ * @brief Apply the current step of the micheline parser
+ *
+ * @param state: parser state
+ * @return tz_parser_result: parser result
+ */
+static tz_parser_result
+tz_micheline_step(tz_parser_state *state)
 {
     tz_micheline_state *m = &state->micheline;
+    tz_parser_result    res;
+    size_t              written;
     uint8_t             b;
     uint8_t             op;
     uint8_t             t;
@@ -244,56 +439,63 @@ tz_micheline_parser_step(tz_parser_state *state)
 
     PRINTF(
         "[DEBUG] micheline(frame: %d, offset:%d/%d, step: %s, errno: %s)\n",
-        (int)(m->frame - m->stack), (int)state->ofs, (int)m->frame->stop,
-        (const char *)PIC(tz_micheline_parser_step_name[m->frame->step]),
+        (int)(m->frame - m->stack), (int)state->ofs,
+        (int)FRAME_GET(m->frame, STOP),
+        (const char *)PIC(
+            tz_micheline_parser_step_name[FRAME_GET(m->frame, STEP)]),
         tz_parser_result_name(state->errno));
 
-    switch (state->micheline.frame->step) {
+    switch (FRAME_GET(state->micheline.frame, STEP)) {
     case TZ_MICHELINE_STEP_INT:
         tz_must(tz_parser_read(state, &b));
         tz_must(
-            tz_parse_int_step(&state->buffers.num, &m->frame->step_int, b));
-        if (m->frame->step_int.stop) {
-            m->frame->step          = TZ_MICHELINE_STEP_PRINT_INT;
-            m->frame->step_int.size = 0;
+            tz_parse_int_step(&state->buffers.num, &m->leaf.num, b));
+        if (m->leaf.num.stop && state->no_render) {
+            tz_must(pop_frame(state));
+        } else if (m->leaf.num.stop) {
+            FRAME_SET(m->frame, STEP, TZ_MICHELINE_STEP_PRINT_INT);
+            m->leaf.num.size = 0;
         }
         break;
     case TZ_MICHELINE_STEP_PRINT_INT:
-        if (m->frame->step_int.sign) {
+        if (m->leaf.num.sign) {
             tz_must(parser_put(state, '-'));
-            m->frame->step_int.sign = 0;
-        } else if (state->buffers.num.decimal[m->frame->step_int.size]) {
-            tz_must(parser_put(
-                state, state->buffers.num.decimal[m->frame->step_int.size]));
-            m->frame->step_int.size++;
-        } else {
-            tz_must(pop_frame(state));
+            m->leaf.num.sign = 0;
         }
+        res = parser_put_span(
+            state, state->buffers.num.decimal + m->leaf.num.size, &written);
+        m->leaf.num.size += (uint16_t)written;
+        tz_must(res);
+        tz_must(pop_frame(state));
         break;
     case TZ_MICHELINE_STEP_SIZE:
         tz_must(tz_parser_read(state, &b));
-        if (m->frame->step_size.size > 255) {
-            tz_raise(TOO_LARGE);  // enforce 16-bit restriction
+        if (m->leaf.size > (TZ_MAX_OFFSET >> 8)) {
+            tz_raise(TOO_LARGE);  // enforce 24-bit restriction
         }
-        m->frame->step_size.size = (m->frame->step_size.size << 8) | b;
-        if (m->frame->stop == state->ofs) {
-            m->frame[-1].stop = state->ofs + m->frame->step_size.size;
+        m->leaf.size = (m->leaf.size << 8) | b;
+        if (FRAME_GET(m->frame, STOP) == (uint32_t)state->ofs) {
+            if (m->leaf.size > (TZ_MAX_OFFSET - (uint32_t)state->ofs)) {
+                tz_raise(TOO_LARGE);
+            }
+            FRAME_SET(&m->frame[-1], STOP,
+                      (uint32_t)state->ofs + m->leaf.size);
             tz_must(pop_frame(state));
         }
         break;
     case TZ_MICHELINE_STEP_SEQ:
-        if (m->frame->stop == state->ofs) {
-            if (m->frame->step_seq.first) {
+        if (FRAME_GET(m->frame, STOP) == (uint32_t)state->ofs) {
+            if (FRAME_GET(m->frame, FIRST)) {
                 tz_must(parser_put(state, '{'));
-                m->frame->step_seq.first = false;
+                FRAME_SET(m->frame, FIRST, false);
             } else {
                 tz_must(parser_put(state, '}'));
                 tz_must(pop_frame(state));
             }
         } else {
-            if (m->frame->step_seq.first) {
+            if (FRAME_GET(m->frame, FIRST)) {
                 tz_must(parser_put(state, '{'));
-                m->frame->step_seq.first = false;
+                FRAME_SET(m->frame, FIRST, false);
             } else {
                 tz_must(parser_put(state, ';'));
             }
@@ -301,45 +503,49 @@ tz_micheline_parser_step(tz_parser_state *state)
         }
         break;
     case TZ_MICHELINE_STEP_PRINT_CAPTURE:
-        if (state->buffers
-                .capture[state->micheline.frame->step_capture.ofs]) {
-            tz_must(parser_put(
-                state, state->buffers.capture[m->frame->step_capture.ofs]));
-            m->frame->step_capture.ofs++;
-        } else {
-            tz_must(pop_frame(state));
-        }
+        res = parser_put_span(
+            state, (const char *)state->buffers.capture + m->leaf.ofs,
+            &written);
+        m->leaf.ofs += (uint16_t)written;
+        tz_must(res);
+        tz_must(pop_frame(state));
         break;
     case TZ_MICHELINE_STEP_BYTES:
-        if (m->frame->step_bytes.has_rem_half) {
-            tz_must(parser_put(state, m->frame->step_bytes.rem_half));
-            m->frame->step_bytes.has_rem_half = 0;
-        } else if (state->micheline.frame->step_bytes.first) {
+        if (FRAME_GET(m->frame, HAS_REM_HALF)) {
+            tz_must(parser_put(state, m->leaf.rem_half));
+            FRAME_SET(m->frame, HAS_REM_HALF, 0);
+        } else if (FRAME_GET(state->micheline.frame, FIRST)) {
             tz_must(parser_put(state, '0'));
-            m->frame->step_bytes.has_rem_half = true;
-            m->frame->step_bytes.rem_half     = 'x';
-            m->frame->step_bytes.first        = false;
-        } else if (m->frame->stop == state->ofs) {
+            FRAME_SET(m->frame, HAS_REM_HALF, true);
+            m->leaf.rem_half = 'x';
+            FRAME_SET(m->frame, FIRST, false);
+        } else if (FRAME_GET(m->frame, STOP) == (uint32_t)state->ofs) {
             tz_must(pop_frame(state));
         } else {
             char half;
             tz_must(tz_parser_peek(state, &b));
+            if (print_bytes_span(state) > 0) {
+                break;
+            }
             half = hex_c[(b & 0xF0) >> 4];
             tz_must(parser_put(state, half));
-            m->frame->step_bytes.has_rem_half = true;
-            m->frame->step_bytes.rem_half     = hex_c[b & 0x0F];
+            FRAME_SET(m->frame, HAS_REM_HALF, true);
+            m->leaf.rem_half = hex_c[b & 0x0F];
             tz_parser_skip(state);
         }
         break;
     case TZ_MICHELINE_STEP_STRING:
-        if (m->frame->step_string.first) {
+        if (FRAME_GET(m->frame, FIRST)) {
             tz_must(parser_put(state, '\"'));
-            m->frame->step_string.first = false;
-        } else if (m->frame->stop == state->ofs) {
+            FRAME_SET(m->frame, FIRST, false);
+        } else if (FRAME_GET(m->frame, STOP) == (uint32_t)state->ofs) {
             tz_must(parser_put(state, '\"'));
             tz_must(pop_frame(state));
         } else {
             tz_must(tz_parser_peek(state, &b));
+            if (print_string_span(state) > 0) {
+                break;
+            }
             if ((b >= 0x20) && (b < 0x80) && (b != '\"') && (b != '\\')) {
                 tz_must(parser_put(state, b));
                 tz_parser_skip(state);
@@ -350,17 +556,17 @@ tz_micheline_parser_step(tz_parser_state *state)
         }
         break;
     case TZ_MICHELINE_STEP_ANNOT:
-        if (m->frame->step_annot.first) {
+        if (FRAME_GET(m->frame, FIRST)) {
             // after reading the size, copy the stop in
             // parent TZ_MICHELINE_STEP_PRIM frame
-            m->frame[-1].stop = m->frame->stop;
+            FRAME_SET(&m->frame[-1], STOP, FRAME_GET(m->frame, STOP));
         }
-        if (m->frame->stop == state->ofs) {
+        if (FRAME_GET(m->frame, STOP) == (uint32_t)state->ofs) {
             tz_must(pop_frame(state));
         } else {
-            if (m->frame->step_annot.first) {
+            if (FRAME_GET(m->frame, FIRST)) {
                 tz_must(parser_put(state, ' '));
-                m->frame->step_annot.first = false;
+                FRAME_SET(m->frame, FIRST, false);
             }
             tz_must(tz_parser_peek(state, &b));
             tz_must(parser_put(state, b));
@@ -372,56 +578,75 @@ tz_micheline_parser_step(tz_parser_state *state)
         if (tz_michelson_op_name(op) == NULL) {
             tz_raise(INVALID_OP);
         }
-        m->frame->step         = TZ_MICHELINE_STEP_PRIM_NAME;
-        m->frame->step_prim.op = op;
+        if ((op == TZ_MICHELSON_OP_Pair) && (FRAME_GET(m->frame, NARGS) == 2)
+            && !FRAME_GET(m->frame, ANNOT) && (m->frame > m->stack)
+            && (FRAME_GET(&m->frame[-1], STEP) == TZ_MICHELINE_STEP_COMB)
+            && (FRAME_GET(&m->frame[-1], NARGS) == 0)) {
+            // last argument of a right comb: its arguments are read in
+            // place as the next arguments of the comb
+            FRAME_SET(&m->frame[-1], NARGS, 1);
+            FRAME_SET(m->frame, STEP, TZ_MICHELINE_STEP_TAG);
+            break;
+        }
+        FRAME_SET(m->frame, STEP, TZ_MICHELINE_STEP_PRIM_NAME);
+        FRAME_SET(m->frame, OP, op);
+        m->leaf.ofs = 0;
         // clang-format off
         m->is_unit = ((m->frame == m->stack)
                       && (op == TZ_MICHELSON_OP_Unit)
-                      && (m->frame->step_prim.nargs == 0)
-                      && (!m->frame->step_prim.annot));
+                      && (FRAME_GET(m->frame, NARGS) == 0)
+                      && (!FRAME_GET(m->frame, ANNOT)));
         // clang-format on
         break;
     case TZ_MICHELINE_STEP_PRIM_NAME:
-        if (m->frame->step_prim.wrap && m->frame->step_prim.first) {
+        if (FRAME_GET(m->frame, WRAP) && (m->leaf.ofs == 0)) {
             tz_must(parser_put(state, '('));
-            m->frame->step_prim.first = false;
+            m->leaf.ofs = 1;
         }
-        if (tz_michelson_op_name(
-                m->frame->step_prim.op)[m->frame->step_prim.ofs]) {
-            tz_must(parser_put(
-                state, tz_michelson_op_name(
-                           m->frame->step_prim.op)[m->frame->step_prim.ofs]));
-            m->frame->step_prim.ofs++;
+        res = parser_put_span(state,
+                              tz_michelson_op_name(
+                                  (uint8_t)FRAME_GET(m->frame, OP))
+                                  + m->leaf.ofs - FRAME_GET(m->frame, WRAP),
+                              &written);
+        m->leaf.ofs += (uint16_t)written;
+        tz_must(res);
+        // a Pair of two arguments without annotation starts a right
+        // comb, printed flat: Pair a (Pair b c) as Pair a b c. Only
+        // the compact encoding is flattened: the arguments and
+        // annotations of a TZ_MICHELINE_TAG_PRIM_N are only known
+        // once printed.
+        if ((FRAME_GET(m->frame, OP) == TZ_MICHELSON_OP_Pair)
+            && (FRAME_GET(m->frame, NARGS) == 2)
+            && !FRAME_GET(m->frame, ANNOT)) {
+            FRAME_SET(m->frame, STEP, TZ_MICHELINE_STEP_COMB);
         } else {
-            m->frame->step = TZ_MICHELINE_STEP_PRIM;
-            if (m->frame->step_prim.nargs == 3) {
-                tz_must(begin_sized(state));
-            }
+            FRAME_SET(m->frame, STEP, TZ_MICHELINE_STEP_PRIM);
+        }
+        if (FRAME_GET(m->frame, NARGS) == 3) {
+            tz_must(begin_sized(state));
         }
         break;
     case TZ_MICHELINE_STEP_PRIM:
-        if ((m->frame->step_prim.nargs == 0)
-            || ((m->frame->step_prim.nargs == 3)
-                && (m->frame->stop == state->ofs))) {
-            if (m->frame->step_prim.annot) {
-                m->frame->step_prim.annot = false;
+    case TZ_MICHELINE_STEP_COMB:
+        if ((FRAME_GET(m->frame, NARGS) == 0)
+            || ((FRAME_GET(m->frame, NARGS) == 3)
+                && (FRAME_GET(m->frame, STOP) == (uint32_t)state->ofs))) {
+            if (FRAME_GET(m->frame, ANNOT)) {
+                FRAME_SET(m->frame, ANNOT, false);
                 tz_must(push_frame(state, TZ_MICHELINE_STEP_ANNOT));
-                m->frame->step_annot.first = true;
+                FRAME_SET(m->frame, FIRST, true);
                 tz_must(begin_sized(state));
             } else {
-                if (m->frame->step_prim.wrap) {
+                if (FRAME_GET(m->frame, WRAP)) {
                     tz_must(parser_put(state, ')'));
                 }
                 tz_must(pop_frame(state));
             }
-        } else if (!m->frame->step_prim.spc) {
-            tz_must(parser_put(state, ' '));
-            m->frame->step_prim.spc = true;
         } else {
-            if (m->frame->step_prim.nargs < 3) {
-                m->frame->step_prim.nargs--;
+            tz_must(parser_put(state, ' '));
+            if (FRAME_GET(m->frame, NARGS) < 3) {
+                FRAME_SET(m->frame, NARGS, FRAME_GET(m->frame, NARGS) - 1);
             }
-            m->frame->step_prim.spc = false;
             tz_must(push_frame(state, TZ_MICHELINE_STEP_TAG));
         }
         break;
@@ -434,3 +659,27 @@ tz_micheline_parser_step(tz_parser_state *state)
     }
     tz_continue;
 }
+
+tz_parser_result
+tz_micheline_parser_step(tz_parser_state *state)
+{
+#ifdef TZ_PARSER_COUNTERS
+    tz_micheline_state *m = &state->micheline;
+
+    if ((m->frame == NULL) || TZ_IS_ERR(state->errno)) {
+        return tz_micheline_step(state);
+    }
+
+    tz_micheline_parser_step_kind step
+        = (tz_micheline_parser_step_kind)FRAME_GET(m->frame, STEP);
+    int                           ofs  = state->ofs;
+    size_t                        oofs = state->regs.oofs;
+    tz_parser_result              res  = tz_micheline_step(state);
+
+    tz_parser_count(state, &state->counters.micheline_steps[step], ofs,
+                    oofs);
+    return res;
+#else
+    return tz_micheline_step(state);
+#endif
+}
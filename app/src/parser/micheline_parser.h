@@ -32,3 +32,8 @@ void tz_micheline_parser_init(tz_parser_state *state);
  * @return tz_parser_result: parser result
  */
 tz_parser_result tz_micheline_parser_step(tz_parser_state *state);
+
+#if defined(TEZOS_DEBUG) || defined(TZ_PARSER_COUNTERS)
+/// Human readable names of the micheline parser steps
+extern const char *const tz_micheline_parser_step_name[];
+#endif
@@ -18,7 +18,7 @@
 
 #include "num_state.h"
 
-#define TZ_MICHELINE_STACK_DEPTH 45  /// Maximum micheline depth handled
+#define TZ_MICHELINE_STACK_DEPTH 90  /// Maximum micheline depth handled
 
 /**
  * @brief Enumeration of all micheline tags
@@ -52,9 +52,13 @@ typedef enum {
     TZ_MICHELINE_STEP_ANNOT,
     TZ_MICHELINE_STEP_INT,
     TZ_MICHELINE_STEP_PRINT_INT,
-    TZ_MICHELINE_STEP_PRINT_CAPTURE
+    TZ_MICHELINE_STEP_PRINT_CAPTURE,
+    TZ_MICHELINE_STEP_COMB
 } tz_micheline_parser_step_kind;
 
+/// Number of micheline parser steps
+#define TZ_MICHELINE_STEP_COUNT (TZ_MICHELINE_STEP_COMB + 1)
+
 /**
  * @brief
  */
@@ -68,52 +72,83 @@ typedef enum {
     TZ_CAP_OR            = 63
 } tz_micheline_capture_kind;
 
+/**
+ * @brief Fields of a micheline frame: shift and mask in its word
+ *
+ *        - STOP: stop offset, all steps
+ *        - STEP: step, all steps
+ *        - FIRST: if read first byte, TZ_MICHELINE_STEP_SEQ,
+ *          TZ_MICHELINE_STEP_BYTES, TZ_MICHELINE_STEP_STRING and
+ *          TZ_MICHELINE_STEP_ANNOT
+ *        - HAS_REM_HALF: if half the byte remains to print,
+ *          TZ_MICHELINE_STEP_BYTES
+ *        - NARGS: number of arguments, WRAP: if wrap in a prim, ANNOT:
+ *          if need to read an annotation, TZ_MICHELINE_STEP_PRIM_OP,
+ *          TZ_MICHELINE_STEP_PRIM_NAME, TZ_MICHELINE_STEP_PRIM and
+ *          TZ_MICHELINE_STEP_COMB
+ *        - OP: prim op, TZ_MICHELINE_STEP_PRIM_OP and
+ *          TZ_MICHELINE_STEP_PRIM_NAME. It overlaps the top of the stop
+ *          offset, which is only set once the name of the prim is
+ *          printed.
+ */
+#define TZ_MICHELINE_FRAME_STOP_SHIFT         0u
+#define TZ_MICHELINE_FRAME_STOP_MASK          0xFFFFFFu
+#define TZ_MICHELINE_FRAME_OP_SHIFT           16u
+#define TZ_MICHELINE_FRAME_OP_MASK            0xFFu
+#define TZ_MICHELINE_FRAME_STEP_SHIFT         24u
+#define TZ_MICHELINE_FRAME_STEP_MASK          0xFu
+#define TZ_MICHELINE_FRAME_FIRST_SHIFT        28u
+#define TZ_MICHELINE_FRAME_FIRST_MASK         0x1u
+#define TZ_MICHELINE_FRAME_HAS_REM_HALF_SHIFT 29u
+#define TZ_MICHELINE_FRAME_HAS_REM_HALF_MASK  0x1u
+#define TZ_MICHELINE_FRAME_NARGS_SHIFT        28u
+#define TZ_MICHELINE_FRAME_NARGS_MASK         0x3u
+#define TZ_MICHELINE_FRAME_WRAP_SHIFT         30u
+#define TZ_MICHELINE_FRAME_WRAP_MASK          0x1u
+#define TZ_MICHELINE_FRAME_ANNOT_SHIFT        31u
+#define TZ_MICHELINE_FRAME_ANNOT_MASK         0x1u
+
+/**
+ * @brief Read a field of a micheline frame
+ *
+ * @param frame: frame
+ * @param field: field name, as in `TZ_MICHELINE_FRAME_<field>_SHIFT`
+ * @return uint32_t: value of the field
+ */
+#define TZ_MICHELINE_FRAME_GET(frame, field)               \
+    (((frame)->word >> TZ_MICHELINE_FRAME_##field##_SHIFT) \
+     & TZ_MICHELINE_FRAME_##field##_MASK)
+
+/**
+ * @brief Write a field of a micheline frame, leaving the others as is
+ *
+ * @param frame: frame
+ * @param field: field name, as in `TZ_MICHELINE_FRAME_<field>_SHIFT`
+ * @param value: value of the field, truncated to the field width
+ */
+#define TZ_MICHELINE_FRAME_SET(frame, field, value)                        \
+    do {                                                                   \
+        (frame)->word                                                      \
+            = ((frame)->word                                               \
+               & ~(TZ_MICHELINE_FRAME_##field##_MASK                       \
+                   << TZ_MICHELINE_FRAME_##field##_SHIFT))                 \
+              | (((uint32_t)(value) & TZ_MICHELINE_FRAME_##field##_MASK)   \
+                 << TZ_MICHELINE_FRAME_##field##_SHIFT);                   \
+    } while (0)
+
 /**
  * @brief This struct represents the frame of the parser of micheline
  *
  *        A frame contains the next step to be performed and its
- *        corresponding context
+ *        corresponding context. It is packed in a 32-bit word, only
+ *        accessed with `TZ_MICHELINE_FRAME_GET` and
+ *        `TZ_MICHELINE_FRAME_SET`. The context of the steps that
+ *        never have a frame above them (numbers, sizes, printing
+ *        offsets and the remaining half of a byte) is kept once in
+ *        `tz_micheline_state`.
  */
 typedef struct {
-    tz_micheline_parser_step_kind step : 4;  /// step
-    uint16_t                      stop;      /// stop offset
-    union {
-        struct {
-            uint16_t size;  /// size read
-        } step_size;        /// TZ_MICHELINE_STEP_SIZE
-        struct {
-            uint8_t first : 1;  /// if read first byte
-        } step_seq;             /// TZ_MICHELINE_STEP_SEQ
-        struct {
-            uint8_t first : 1;         /// if read first byte
-            uint8_t has_rem_half : 1;  /// if half the byte remains to print
-            uint8_t rem_half;          /// remaining half of the byte
-        } step_bytes;                  /// TZ_MICHELINE_STEP_BYTES
-        struct {
-            uint8_t first : 1;  /// if read first byte
-        } step_string;          /// TZ_MICHELINE_STEP_STRING
-        struct {
-            uint8_t first : 1;        /// if read first byte
-        } step_annot;                 /// TZ_MICHELINE_STEP_ANNOT
-        tz_num_parser_regs step_int;  /// number parser register
-                                      /// TZ_MICHELINE_STEP_INT,
-                                      /// TZ_MICHELINE_STEP_PRINT_INT
-        struct {
-            uint8_t op;         /// prim op
-            uint8_t ofs;        /// offset
-            uint8_t nargs : 2;  /// number of arguments
-            uint8_t wrap : 1;   /// if wrap in a prim
-            uint8_t spc : 1;    /// if has space
-            uint8_t annot : 1;  /// if need to read an annotation
-            uint8_t first : 1;  /// if read first byte
-        } step_prim;            /// TZ_MICHELINE_STEP_PRIM_OP,
-                                /// TZ_MICHELINE_STEP_PRIM_NAME,
-                                /// TZ_MICHELINE_STEP_PRIM
-        struct {
-            int ofs;     /// offset of the capture buffer
-        } step_capture;  /// TZ_MICHELINE_STEP_CAPTURE_BYTES,
-                         /// TZ_MICHELINE_STEP_PRINT_CAPTURE
-    };
+    uint32_t word;  /// fields of the frame
 } tz_micheline_parser_frame;
 
 /**
@@ -129,5 +164,19 @@ typedef struct {
         stack[TZ_MICHELINE_STACK_DEPTH];  /// stack of frames
     tz_micheline_parser_frame *frame;     /// current frame
                                           /// init == stack, NULL when done
+    union {
+        tz_num_parser_regs num;  /// number parser register
+                                 /// TZ_MICHELINE_STEP_INT,
+                                 /// TZ_MICHELINE_STEP_PRINT_INT
+        uint32_t size;           /// size read
+                                 /// TZ_MICHELINE_STEP_SIZE
+        uint16_t ofs;            /// printing offset, counting the
+                                 /// opening parenthesis of a prim
+                                 /// TZ_MICHELINE_STEP_PRIM_NAME,
+                                 /// TZ_MICHELINE_STEP_PRINT_CAPTURE
+        char rem_half;           /// remaining half of a byte
+                                 /// TZ_MICHELINE_STEP_BYTES
+    } leaf;  /// context of the current frame, which is always the top
+             /// one for the steps above
     bool is_unit;  /// indicates whether the micheline read is a unit
 } tz_micheline_state;
@@ -21,10 +21,13 @@ void
 tz_parse_num_state_init(tz_num_parser_buffer *buffers,
                         tz_num_parser_regs   *regs)
 {
-    buffers->bytes[0] = 0;
-    regs->size        = 0;
-    regs->sign        = 0;
-    regs->stop        = 0;
+    buffers->bytes[0]  = 0;
+    buffers->value     = 0;
+    regs->size         = 0;
+    regs->sign         = 0;
+    regs->stop         = 0;
+    regs->overflow     = 0;
+    regs->skip_decimal = 0;
 }
 
 tz_parser_result
@@ -41,6 +44,16 @@ tz_parse_num_step(tz_num_parser_buffer *buffers, tz_num_parser_regs *regs,
         v = b & 0x7F;
         s = 7;
     }
+    if (!regs->overflow) {
+        // keep a native copy of the number while it fits in 64 bits
+        if (regs->size >= 64) {
+            regs->overflow = (v != 0);
+        } else if ((regs->size > 57) && (v >> (64 - regs->size))) {
+            regs->overflow = 1;
+        } else {
+            buffers->value |= (uint64_t)v << regs->size;
+        }
+    }
     uint8_t lo     = v << (regs->size & 7);
     uint8_t hi     = v >> (8 - (regs->size & 7));
     int     lo_idx = regs->size / 8;
@@ -58,8 +71,16 @@ tz_parse_num_step(tz_num_parser_buffer *buffers, tz_num_parser_regs *regs,
     }
     if (!cont) {
         regs->stop = true;
-        tz_format_decimal(buffers->bytes, (regs->size + 7) / 8,
-                          buffers->decimal, sizeof(buffers->decimal));
+        if (regs->skip_decimal) {
+            return TZ_CONTINUE;
+        }
+        if (regs->overflow) {
+            tz_format_decimal(buffers->bytes, (regs->size + 7) / 8,
+                              buffers->decimal, sizeof(buffers->decimal));
+        } else {
+            tz_format_u64(buffers->value, buffers->decimal,
+                          sizeof(buffers->decimal));
+        }
     }
     return TZ_CONTINUE;
 }
@@ -77,23 +98,3 @@ tz_parse_nat_step(tz_num_parser_buffer *buffers, tz_num_parser_regs *regs,
 {
     return tz_parse_num_step(buffers, regs, b, 1);
 }
-
-bool
-tz_string_to_mutez(const char *str, uint64_t *res)
-{
-    if ((str == NULL) || (res == NULL)) {
-        PRINTF("[ERROR] Null parameter\n");
-        return false;
-    }
-
-    *res = 0;
-    for (int i = 0; str[i] != '\0'; i++) {
-        if ((str[i] < '0') || (str[i] > '9')) {
-            PRINTF("[ERROR] Non-digit character: %c\n", str[i]);
-            return false;
-        }
-        *res = (*res * 10) + (str[i] - '0');
-    }
-
-    return true;
-}
@@ -62,12 +62,3 @@ tz_parser_result tz_parse_int_step(tz_num_parser_buffer *buffers,
  */
 tz_parser_result tz_parse_nat_step(tz_num_parser_buffer *buffers,
                                    tz_num_parser_regs *regs, uint8_t b);
-
-/**
- * @brief format a buffer to mutez number
- *
- * @param in: intput buffer
- * @param out: output number
- * @return bool: success
- */
-bool tz_string_to_mutez(const char *in, uint64_t *out);
@@ -27,6 +27,8 @@ typedef struct {
     uint16_t size;      /// size of the number
     uint8_t  sign : 1;  /// sign ot the number
     uint8_t  stop : 1;  /// number as been fully parsed
+    uint8_t  overflow : 1;  /// number does not fit in 64 bits
+    uint8_t  skip_decimal : 1;  /// do not format the number in decimal
 } tz_num_parser_regs;
 
 #define TZ_NUM_BUFFER_SIZE 256  /// Size of the number buffer
@@ -35,6 +37,8 @@ typedef struct {
  * @brief This struct represents the output buffers for the parser of a number
  */
 typedef struct {
-    uint8_t bytes[TZ_NUM_BUFFER_SIZE / 8];                         /// bytes
-    char decimal[TZ_DECIMAL_BUFFER_SIZE(TZ_NUM_BUFFER_SIZE / 8)];  /// decimal
+    uint8_t  bytes[TZ_NUM_BUFFER_SIZE / 8];  /// bytes
+    uint64_t value;  /// absolute value, unless `overflow` is set
+    char    decimal[TZ_DECIMAL_BUFFER_SIZE(TZ_NUM_BUFFER_SIZE / 8)
+                 + 1];  /// decimal, with room for the null terminator
 } tz_num_parser_buffer;
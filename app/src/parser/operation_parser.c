@@ -28,7 +28,7 @@ static tz_parser_result push_frame(tz_parser_state              *state,
                                    tz_operation_parser_step_kind step);
 static tz_parser_result pop_frame(tz_parser_state *state);
 
-#ifdef TEZOS_DEBUG
+#if defined(TEZOS_DEBUG) || defined(TZ_PARSER_COUNTERS)
 const char *const tz_operation_parser_step_name[] = {"OPTION",
                                                      "TUPLE",
                                                      "MAGIC",
@@ -43,6 +43,7 @@ const char *const tz_operation_parser_step_name[] = {"OPTION",
                                                      "READ_NUM",
                                                      "READ_INT32",
                                                      "READ_PK",
+                                                     "READ_BLS_SIG",
                                                      "READ_BYTES",
                                                      "READ_STRING",
                                                      "READ_SMART_ENTRYPOINT",
@@ -317,13 +318,37 @@ pop_frame(tz_parser_state *state)
 }
 
 void
-tz_operation_parser_set_size(tz_parser_state *state, uint16_t size)
+tz_operation_parser_set_size(tz_parser_state *state, uint32_t size)
 {
-    state->operation.stack[0].stop = size;
+    state->operation.stack[0].stop = size & TZ_MAX_OFFSET;
 }
 
+#ifdef TZ_OPERATION_CHECKPOINT
 void
-tz_operation_parser_init(tz_parser_state *state, uint16_t size,
+tz_operation_parser_restore(tz_parser_state               *state,
+                            uint32_t                       size,
+                            const tz_operation_checkpoint *checkpoint)
+{
+    tz_operation_state *op = &state->operation;
+
+    // the descriptor is set again by the tag read first
+    tz_operation_parser_init(state, size, true);
+    state->ofs                    = (int)checkpoint->ofs;
+    state->field_info.field_index = checkpoint->field_index;
+    op->batch_index               = checkpoint->batch_index;
+    op->total_fee                 = checkpoint->total_fee;
+    op->total_amount              = checkpoint->total_amount;
+    op->checkpoint                = *checkpoint;
+    op->stack[0].step             = TZ_OPERATION_STEP_BATCH;
+    op->frame                     = op->stack;
+    push_frame(state, TZ_OPERATION_STEP_TAG);  // ignore result,
+                                               // assume success
+    op->frame->stop = 0;
+}
+#endif
+
+void
+tz_operation_parser_init(tz_parser_state *state, uint32_t size,
                          bool skip_magic)
 {
     tz_operation_state *op = &state->operation;
@@ -339,8 +364,13 @@ tz_operation_parser_init(tz_parser_state *state, uint16_t size,
 #endif  // HAVE_SWAP
     op->total_fee     = 0;
     op->total_amount  = 0;
+    op->hook          = NULL;
+    op->descriptor    = NULL;
+#ifdef TZ_OPERATION_CHECKPOINT
+    memset(&op->checkpoint, 0, sizeof(op->checkpoint));
+#endif
     op->frame         = op->stack;
-    op->stack[0].stop = size;
+    op->stack[0].stop = size & TZ_MAX_OFFSET;
     if (!skip_magic) {
         op->stack[0].step = TZ_OPERATION_STEP_MAGIC;
     } else {
@@ -377,7 +407,7 @@ tz_print_string(tz_parser_state *state)
 {
     tz_operation_state *op = &state->operation;
 
-    if (op->frame->step_read_string.skip) {
+    if (op->frame->step_read_string.skip || state->no_render) {
         tz_must(pop_frame(state));
         tz_continue;
     }
@@ -520,18 +550,45 @@ tz_step_size(tz_parser_state *state)
     tz_operation_state *op = &state->operation;
     uint8_t             b;
     tz_must(tz_parser_read(state, &b));
-    if (op->frame->step_size.size > 255) {
-        tz_raise(TOO_LARGE);  // enforce 16-bit restriction
+    if (op->frame->step_size.size > (TZ_MAX_OFFSET >> 8)) {
+        tz_raise(TOO_LARGE);  // enforce 24-bit restriction
     }
     op->frame->step_size.size = (op->frame->step_size.size << 8) | b;
     op->frame->step_size.size_len--;
     if (op->frame->step_size.size_len == 0) {
-        op->frame[-1].stop = state->ofs + op->frame->step_size.size;
+        if (op->frame->step_size.size
+            > (TZ_MAX_OFFSET - (uint32_t)state->ofs)) {
+            tz_raise(TOO_LARGE);
+        }
+        op->frame[-1].stop
+            = ((uint32_t)state->ofs + op->frame->step_size.size)
+              & TZ_MAX_OFFSET;
         tz_must(pop_frame(state));
     }
     tz_continue;
 }
 
+#ifdef TZ_OPERATION_CHECKPOINT
+/**
+ * @brief Record the checkpoint of the operation whose tag is read
+ *        next, the batch can be parsed again from it
+ *
+ * @param state: parser state
+ */
+static void
+save_checkpoint(tz_parser_state *state)
+{
+    tz_operation_state      *op = &state->operation;
+    tz_operation_checkpoint *cp = &op->checkpoint;
+
+    cp->total_fee    = op->total_fee;
+    cp->total_amount = op->total_amount;
+    cp->ofs          = (uint32_t)state->ofs;
+    cp->field_index  = state->field_info.field_index;
+    cp->batch_index  = op->batch_index;
+}
+#endif
+
 /**
  * @brief Find the operation associated to the operation tag and ask
  *        to read its fields
@@ -546,6 +603,9 @@ tz_step_tag(tz_parser_state *state)
     tz_operation_state            *op = &state->operation;
     const tz_operation_descriptor *d;
     uint8_t                        t;
+#ifdef TZ_OPERATION_CHECKPOINT
+    save_checkpoint(state);
+#endif
     tz_must(tz_parser_read(state, &t));
 #ifdef HAVE_SWAP
     op->last_tag = t;
@@ -555,9 +615,17 @@ tz_step_tag(tz_parser_state *state)
 #endif  // HAVE_SWAP
     for (d = tz_operation_descriptors; d->tag != TZ_OPERATION_TAG_END; d++) {
         if (d->tag == t) {
+#ifdef TZ_PARSER_COUNTERS
+            state->counters.current_tag
+                = (uint8_t)(d - tz_operation_descriptors + 1);
+#endif
+            op->descriptor                    = d;
             op->frame->step                   = TZ_OPERATION_STEP_TUPLE;
             op->frame->step_tuple.fields      = d->fields;
             op->frame->step_tuple.field_index = 0;
+            if (state->no_render) {
+                tz_continue;
+            }
             tz_must(push_frame(state, TZ_OPERATION_STEP_PRINT));
             snprintf(state->field_info.field_name, 30, "Operation (%d)",
                      op->batch_index);
@@ -663,6 +731,23 @@ add_currency:
     str[len] = 0;
 }
 
+/**
+ * @brief Pass a decoded field to the hook of the operation state, if any
+ *
+ * @param state: parser state
+ * @param kind: kind of the field decoded
+ * @return tz_parser_result: parser result
+ */
+static tz_parser_result
+call_hook(tz_parser_state *state, tz_operation_field_kind kind)
+{
+    tz_operation_hook hook = state->operation.hook;
+    if ((hook != NULL) && !hook(kind)) {
+        tz_raise(REJECTED);
+    }
+    tz_continue;
+}
+
 /**
  * @brief Read a number
  *
@@ -680,21 +765,26 @@ tz_step_read_num(tz_parser_state *state)
                               &op->frame->step_read_num.state, b,
                               op->frame->step_read_num.natural));
     if (op->frame->step_read_num.state.stop) {
-        uint64_t value;
-        if (!tz_string_to_mutez(state->buffers.num.decimal, &value)) {
-            tz_raise(INVALID_DATA);
-        }
+        uint64_t value = state->buffers.num.value;
         switch (op->frame->step_read_num.kind) {
         case TZ_OPERATION_FIELD_AMOUNT:
+            if (op->frame->step_read_num.state.overflow) {
+                tz_raise(TOO_LARGE);
+            }
             op->total_amount += value;
+            tz_must(call_hook(state, TZ_OPERATION_FIELD_AMOUNT));
             break;
         case TZ_OPERATION_FIELD_FEE:
+            if (op->frame->step_read_num.state.overflow) {
+                tz_raise(TOO_LARGE);
+            }
             op->total_fee += value;
+            tz_must(call_hook(state, TZ_OPERATION_FIELD_FEE));
             break;
         default:
             break;
         }
-        if (op->frame->step_read_num.skip) {
+        if (op->frame->step_read_num.skip || state->no_render) {
             tz_must(pop_frame(state));
             tz_continue;
         }
@@ -735,7 +825,9 @@ tz_step_read_int32(tz_parser_state *state)
         *value = (*value << 8) | b;
         op->frame->step_read_int32.ofs++;
     } else {
-        snprintf((char *)CAPTURE, sizeof(CAPTURE), "%d", *value);
+        if (!state->no_render) {
+            snprintf((char *)CAPTURE, sizeof(CAPTURE), "%d", *value);
+        }
         op->frame->step_read_string.skip = op->frame->step_read_int32.skip;
         tz_must(tz_print_string(state));
     }
@@ -752,78 +844,85 @@ static tz_parser_result
 tz_step_read_bytes(tz_parser_state *state)
 {
     ASSERT_STEP(state, READ_BYTES);
-    tz_operation_state *op = &state->operation;
+    tz_operation_state *op  = &state->operation;
+    char               *out = state->no_render ? NULL : (char *)CAPTURE;
     if (op->frame->step_read_bytes.ofs < op->frame->step_read_bytes.len) {
-        uint8_t *c;
-        c = &CAPTURE[op->frame->step_read_bytes.ofs];
-        tz_must(tz_parser_read(state, c));
-        op->frame->step_read_bytes.ofs++;
+        size_t read;
+        // Fixed-width fields are copied in bulk to avoid a step per byte
+        tz_must(tz_parser_read_bytes(
+            state, &CAPTURE[op->frame->step_read_bytes.ofs],
+            op->frame->step_read_bytes.len - op->frame->step_read_bytes.ofs,
+            &read));
+        op->frame->step_read_bytes.ofs += (uint16_t)read;
     } else {
         if (op->frame->step_read_num.skip) {
             tz_must(pop_frame(state));
             tz_continue;
         }
+        // when not rendering, `out` is NULL: the data is only checked
         switch (op->frame->step_read_bytes.kind) {
         case TZ_OPERATION_FIELD_SOURCE:
             memcpy(op->source, CAPTURE, 22);
             __attribute__((fallthrough));
         case TZ_OPERATION_FIELD_PKH:
-            if (tz_format_pkh(CAPTURE, 21, (char *)CAPTURE,
-                              sizeof(CAPTURE))) {
+            if (tz_format_pkh(CAPTURE, 21, out, sizeof(CAPTURE))) {
                 tz_raise(INVALID_TAG);
             }
             break;
         case TZ_OPERATION_FIELD_PK:
-            if (tz_format_pk(CAPTURE, op->frame->step_read_bytes.len,
-                             (char *)CAPTURE, sizeof(CAPTURE))) {
+            if (tz_format_pk(CAPTURE, op->frame->step_read_bytes.len, out,
+                             sizeof(CAPTURE))) {
                 tz_raise(INVALID_TAG);
             }
             break;
         case TZ_OPERATION_FIELD_BLS_SIG:
-            if (tz_format_sig(CAPTURE, op->frame->step_read_bytes.len,
-                              (char *)CAPTURE, sizeof(CAPTURE))) {
+            if (tz_format_sig(CAPTURE, op->frame->step_read_bytes.len, out,
+                              sizeof(CAPTURE))) {
                 tz_raise(INVALID_TAG);
             }
             break;
         case TZ_OPERATION_FIELD_SR:
-            if (tz_format_base58check("sr1", CAPTURE, 20, (char *)CAPTURE,
-                                      sizeof(CAPTURE))) {
+            if (tz_format_base58check_kind(TZ_BASE58CHECK_SR1, CAPTURE, 20,
+                                           out, sizeof(CAPTURE))) {
                 tz_raise(INVALID_TAG);
             }
             break;
         case TZ_OPERATION_FIELD_SRC:
-            if (tz_format_base58check("src1", CAPTURE, 32, (char *)CAPTURE,
-                                      sizeof(CAPTURE))) {
+            if (tz_format_base58check_kind(TZ_BASE58CHECK_SRC1, CAPTURE, 32,
+                                           out, sizeof(CAPTURE))) {
                 tz_raise(INVALID_TAG);
             }
             break;
         case TZ_OPERATION_FIELD_PROTO:
-            if (tz_format_base58check("proto", CAPTURE, 32, (char *)CAPTURE,
-                                      sizeof(CAPTURE))) {
+            if (tz_format_base58check_kind(TZ_BASE58CHECK_PROTO, CAPTURE, 32,
+                                           out, sizeof(CAPTURE))) {
                 tz_raise(INVALID_TAG);
             }
             break;
         case TZ_OPERATION_FIELD_DESTINATION:
             memcpy(op->destination, CAPTURE, 22);
-            if (tz_format_address(CAPTURE, 22, (char *)CAPTURE,
-                                  sizeof(CAPTURE))) {
+            tz_must(call_hook(state, TZ_OPERATION_FIELD_DESTINATION));
+            if (tz_format_address(CAPTURE, 22, out, sizeof(CAPTURE))) {
                 tz_raise(INVALID_TAG);
             }
             break;
         case TZ_OPERATION_FIELD_OPH:
-            if (tz_format_oph(CAPTURE, 32, (char *)CAPTURE,
-                              sizeof(CAPTURE))) {
+            if (tz_format_oph(CAPTURE, 32, out, sizeof(CAPTURE))) {
                 tz_raise(INVALID_TAG);
             }
             break;
         case TZ_OPERATION_FIELD_BH:
-            if (tz_format_bh(CAPTURE, 32, (char *)CAPTURE, sizeof(CAPTURE))) {
+            if (tz_format_bh(CAPTURE, 32, out, sizeof(CAPTURE))) {
                 tz_raise(INVALID_TAG);
             }
             break;
         default:
             tz_raise(INVALID_STATE);
         }
+        if (state->no_render) {
+            tz_must(pop_frame(state));
+            tz_continue;
+        }
         op->frame->step           = TZ_OPERATION_STEP_PRINT;
         op->frame->step_print.str = (char *)CAPTURE;
     }
@@ -905,6 +1004,13 @@ tz_step_read_binary(tz_parser_state *state)
     if (state->ofs == op->frame->stop) {
         CAPTURE[op->frame->step_read_string.ofs] = 0;
         tz_must(tz_print_string(state));
+    } else if (op->frame->step_read_string.skip || state->no_render) {
+        size_t read;
+        // nothing to print: read the input in bulk
+        tz_must(tz_parser_read_bytes(
+            state, CAPTURE,
+            MIN((size_t)(op->frame->stop - state->ofs), sizeof(CAPTURE)),
+            &read));
     } else if ((op->frame->step_read_string.ofs + 2)
                >= TZ_CAPTURE_BUFFER_SIZE) {
         CAPTURE[op->frame->step_read_string.ofs] = 0;
@@ -1110,6 +1216,8 @@ tz_step_field(tz_parser_state *state)
         op->frame->step_read_num.kind    = field->kind;
         op->frame->step_read_num.skip    = field->skip;
         op->frame->step_read_num.natural = 1;
+        op->frame->step_read_num.state.skip_decimal
+            = field->skip || state->no_render;
         break;
     }
     case TZ_OPERATION_FIELD_INT: {
@@ -1119,6 +1227,8 @@ tz_step_field(tz_parser_state *state)
         op->frame->step_read_num.kind    = field->kind;
         op->frame->step_read_num.skip    = field->skip;
         op->frame->step_read_num.natural = 0;
+        op->frame->step_read_num.state.skip_decimal
+            = field->skip || state->no_render;
         break;
     }
     case TZ_OPERATION_FIELD_INT32: {
@@ -1413,7 +1523,7 @@ tz_step_read_protos(tz_parser_state *state)
 }
 
 /**
- * @brief Print a string
+ * @brief Print the rest of a string, as much as the output allows
  *
  * @param state: parser state
  * @param partial: If partial true, then the string is not yet
@@ -1421,33 +1531,94 @@ tz_step_read_protos(tz_parser_state *state)
  * @return tz_parser_result: parser result
  */
 static tz_parser_result
-tz_step_print(tz_parser_state *state, bool partial)
+tz_print_remaining(tz_parser_state *state, bool partial)
 {
-    if ((state->operation.frame->step != TZ_OPERATION_STEP_PRINT)
-        && (state->operation.frame->step
-            != TZ_OPERATION_STEP_PARTIAL_PRINT)) {
-        PRINTF("[DEBUG] expected step %s or step %s but got step %s)\n",
-               STRING_STEP(TZ_OPERATION_STEP_PRINT),
-               STRING_STEP(TZ_OPERATION_STEP_PARTIAL_PRINT),
-               STRING_STEP(state->operation.frame->step));
-        tz_raise(INVALID_STATE);
-    }
     tz_operation_state *op  = &state->operation;
     const char         *str = PIC(op->frame->step_print.str);
-    if (*str) {
-        tz_must(tz_parser_put(state, *str));
-        op->frame->step_print.str++;
-    } else {
+    size_t              written;
+    tz_parser_result    res;
+
+    if (state->no_render) {
         tz_must(pop_frame(state));
-        if (!partial) {
-            tz_stop(IM_FULL);
-        }
+        tz_continue;
+    }
+    res = tz_parser_put_span(state, str, &written);
+
+    op->frame->step_print.str += written;
+    tz_must(res);
+    tz_must(pop_frame(state));
+    if (!partial) {
+        tz_stop(IM_FULL);
     }
     tz_continue;
 }
 
-tz_parser_result
-tz_operation_parser_step(tz_parser_state *state)
+/**
+ * @brief Print a complete string, then ask for a flush
+ *
+ * @param state: parser state
+ * @return tz_parser_result: parser result
+ */
+static tz_parser_result
+tz_step_print(tz_parser_state *state)
+{
+    ASSERT_STEP(state, PRINT);
+    return tz_print_remaining(state, false);
+}
+
+/**
+ * @brief Print a part of a string, the rest follows
+ *
+ * @param state: parser state
+ * @return tz_parser_result: parser result
+ */
+static tz_parser_result
+tz_step_partial_print(tz_parser_state *state)
+{
+    ASSERT_STEP(state, PARTIAL_PRINT);
+    return tz_print_remaining(state, true);
+}
+
+/// Handler of a step of the operations parser
+typedef tz_parser_result (*tz_operation_step_handler)(tz_parser_state *);
+
+/// Handlers of the operations parser steps, indexed by step kind
+static const tz_operation_step_handler
+    tz_operation_step_handlers[TZ_OPERATION_STEP_COUNT]
+    = {[TZ_OPERATION_STEP_OPTION]                = tz_step_option,
+       [TZ_OPERATION_STEP_TUPLE]                 = tz_step_tuple,
+       [TZ_OPERATION_STEP_MAGIC]                 = tz_step_magic,
+       [TZ_OPERATION_STEP_READ_BINARY]           = tz_step_read_binary,
+       [TZ_OPERATION_STEP_BRANCH]                = tz_step_branch,
+       [TZ_OPERATION_STEP_BATCH]                 = tz_step_batch,
+       [TZ_OPERATION_STEP_TAG]                   = tz_step_tag,
+       [TZ_OPERATION_STEP_SIZE]                  = tz_step_size,
+       [TZ_OPERATION_STEP_FIELD]                 = tz_step_field,
+       [TZ_OPERATION_STEP_PRINT]                 = tz_step_print,
+       [TZ_OPERATION_STEP_PARTIAL_PRINT]         = tz_step_partial_print,
+       [TZ_OPERATION_STEP_READ_NUM]              = tz_step_read_num,
+       [TZ_OPERATION_STEP_READ_INT32]            = tz_step_read_int32,
+       [TZ_OPERATION_STEP_READ_PK]               = tz_step_read_pk,
+       [TZ_OPERATION_STEP_READ_BLS_SIG]          = tz_step_read_bls_sig,
+       [TZ_OPERATION_STEP_READ_BYTES]            = tz_step_read_bytes,
+       [TZ_OPERATION_STEP_READ_STRING]           = tz_step_read_string,
+       [TZ_OPERATION_STEP_READ_SMART_ENTRYPOINT]
+       = tz_step_read_smart_entrypoint,
+       [TZ_OPERATION_STEP_READ_MICHELINE]     = tz_step_read_micheline,
+       [TZ_OPERATION_STEP_READ_SORU_MESSAGES] = tz_step_read_soru_messages,
+       [TZ_OPERATION_STEP_READ_SORU_KIND]     = tz_step_read_soru_kind,
+       [TZ_OPERATION_STEP_READ_BALLOT]        = tz_step_read_ballot,
+       [TZ_OPERATION_STEP_READ_PROTOS]        = tz_step_read_protos,
+       [TZ_OPERATION_STEP_READ_PKH_LIST]      = tz_step_read_pkh_list};
+
+/**
+ * @brief Apply the current step of the operations parser
+ *
+ * @param state: parser state
+ * @return tz_parser_result: parser result
+ */
+static tz_parser_result
+tz_operation_step(tz_parser_state *state)
 {
     tz_operation_state *op = &state->operation;
 
@@ -1468,80 +1639,143 @@ tz_operation_parser_step(tz_parser_state *state)
         (int)state->regs.ilen, (int)state->regs.oofs,
         STRING_STEP(op->frame->step), tz_parser_result_name(state->errno));
 
-    switch (op->frame->step) {
-    case TZ_OPERATION_STEP_OPTION:
-        tz_must(tz_step_option(state));
-        break;
-    case TZ_OPERATION_STEP_TUPLE:
-        tz_must(tz_step_tuple(state));
-        break;
-    case TZ_OPERATION_STEP_MAGIC:
-        tz_must(tz_step_magic(state));
-        break;
-    case TZ_OPERATION_STEP_SIZE:
-        tz_must(tz_step_size(state));
-        break;
-    case TZ_OPERATION_STEP_TAG:
-        tz_must(tz_step_tag(state));
-        break;
-    case TZ_OPERATION_STEP_READ_MICHELINE:
-        tz_must(tz_step_read_micheline(state));
-        break;
-    case TZ_OPERATION_STEP_READ_NUM:
-        tz_must(tz_step_read_num(state));
-        break;
-    case TZ_OPERATION_STEP_READ_INT32:
-        tz_must(tz_step_read_int32(state));
-        break;
-    case TZ_OPERATION_STEP_READ_BYTES:
-        tz_must(tz_step_read_bytes(state));
-        break;
-    case TZ_OPERATION_STEP_BRANCH:
-        tz_must(tz_step_branch(state));
-        break;
-    case TZ_OPERATION_STEP_BATCH:
-        tz_must(tz_step_batch(state));
-        break;
-    case TZ_OPERATION_STEP_READ_STRING:
-        tz_must(tz_step_read_string(state));
-        break;
-    case TZ_OPERATION_STEP_READ_BINARY:
-        tz_must(tz_step_read_binary(state));
-        break;
-    case TZ_OPERATION_STEP_READ_SMART_ENTRYPOINT:
-        tz_must(tz_step_read_smart_entrypoint(state));
-        break;
-    case TZ_OPERATION_STEP_FIELD:
-        tz_must(tz_step_field(state));
-        break;
-    case TZ_OPERATION_STEP_READ_PK:
-        tz_must(tz_step_read_pk(state));
-        break;
-    case TZ_OPERATION_STEP_READ_BLS_SIG:
-        tz_must(tz_step_read_bls_sig(state));
-        break;
-    case TZ_OPERATION_STEP_READ_SORU_MESSAGES:
-        tz_must(tz_step_read_soru_messages(state));
-        break;
-    case TZ_OPERATION_STEP_READ_SORU_KIND:
-        tz_must(tz_step_read_soru_kind(state));
-        break;
-    case TZ_OPERATION_STEP_READ_BALLOT:
-        tz_must(tz_step_read_ballot(state));
-        break;
-    case TZ_OPERATION_STEP_READ_PROTOS:
-        tz_must(tz_step_read_protos(state));
-        break;
-    case TZ_OPERATION_STEP_READ_PKH_LIST:
-        tz_must(tz_step_read_pkh_list(state));
-        break;
-    case TZ_OPERATION_STEP_PRINT:
-    case TZ_OPERATION_STEP_PARTIAL_PRINT:
-        tz_must(tz_step_print(
-            state, op->frame->step == TZ_OPERATION_STEP_PARTIAL_PRINT));
-        break;
-    default:
+    // a corrupted step must not index past the table
+    if ((unsigned int)op->frame->step >= TZ_OPERATION_STEP_COUNT) {
         tz_raise(INVALID_STATE);
     }
+    tz_operation_step_handler handler
+        = (tz_operation_step_handler)PIC(
+            tz_operation_step_handlers[op->frame->step]);
+    if (handler == NULL) {
+        tz_raise(INVALID_STATE);
+    }
+    tz_must(handler(state));
     tz_continue;
 }
+
+tz_parser_result
+tz_operation_parser_step(tz_parser_state *state)
+{
+#ifdef TZ_PARSER_COUNTERS
+    tz_operation_state *op = &state->operation;
+
+    if ((op->frame == NULL) || TZ_IS_ERR(state->errno)) {
+        return tz_operation_step(state);
+    }
+
+    tz_parser_counters           *counters = &state->counters;
+    tz_operation_parser_step_kind step     = op->frame->step;
+    int                           ofs      = state->ofs;
+    size_t                        oofs     = state->regs.oofs;
+    tz_parser_result              res      = tz_operation_step(state);
+
+    tz_parser_count(state, &counters->operation_steps[step], ofs, oofs);
+    // read after the step so the tag byte accounts for its operation
+    tz_parser_count(state, &counters->operation_tags[counters->current_tag],
+                    ofs, oofs);
+    return res;
+#else
+    return tz_operation_step(state);
+#endif
+}
+
+tz_parser_result
+tz_operation_parser_run(tz_parser_state *state, size_t *steps)
+{
+    tz_parser_result res;
+    size_t           n = 0;
+
+    do {
+        n++;
+        res = tz_operation_parser_step(state);
+    } while (!TZ_IS_BLOCKED(res));
+    if (steps != NULL) {
+        *steps += n;
+    }
+    return res;
+}
+
+/**
+ * @brief Shortest value a field of a given kind can display
+ *
+ * @param kind: kind of the field
+ * @return size_t: minimum number of characters displayed
+ */
+static size_t
+field_min_length(tz_operation_field_kind kind)
+{
+    switch (kind) {
+    case TZ_OPERATION_FIELD_SOURCE:
+    case TZ_OPERATION_FIELD_PKH:
+    case TZ_OPERATION_FIELD_DESTINATION:
+    case TZ_OPERATION_FIELD_SR:
+        return 36;  // base58 of a 20-bytes hash: tz1, KT1, sr1, ...
+    case TZ_OPERATION_FIELD_PROTO:
+        return 51;  // base58 of a 32-bytes protocol hash
+    case TZ_OPERATION_FIELD_PK:
+    case TZ_OPERATION_FIELD_SRC:
+        return 54;  // base58 of a 32-bytes key or commitment: edpk, src1
+    default:
+        return 1;
+    }
+}
+
+/**
+ * @brief Compute a lower bound of the number of screens needed to
+ *        display a field
+ *
+ * @param field: field descriptor
+ * @param screen_size: maximum number of characters of a screen
+ * @return size_t: lower bound
+ */
+static size_t
+field_min_screens(const tz_operation_field_descriptor *field,
+                  size_t                               screen_size)
+{
+    const tz_operation_field_descriptor *f;
+    size_t                               screens = 0;
+
+    if (field->skip) {
+        return 0;
+    }
+    switch (field->kind) {
+    case TZ_OPERATION_FIELD_OPTION:
+        // when absent, the option is either hidden or a single screen
+        if (!field->field_option.display_none) {
+            return 0;
+        }
+        return MIN(1, field_min_screens(PIC(field->field_option.field),
+                                        screen_size));
+    case TZ_OPERATION_FIELD_TUPLE:
+        for (f = PIC(field->field_tuple.fields);
+             f->kind != TZ_OPERATION_FIELD_END; f++) {
+            screens += field_min_screens(f, screen_size);
+        }
+        return screens;
+    case TZ_OPERATION_FIELD_PROTOS:
+    case TZ_OPERATION_FIELD_SORU_MESSAGES:
+    case TZ_OPERATION_FIELD_PKH_LIST:
+        // lists can be empty
+        return 0;
+    default:
+        return (field_min_length(field->kind) + screen_size - 1)
+               / screen_size;
+    }
+}
+
+size_t
+tz_operation_parser_min_screens(const tz_parser_state *state,
+                                size_t                 screen_size)
+{
+    const tz_operation_descriptor       *d = state->operation.descriptor;
+    const tz_operation_field_descriptor *f;
+    size_t                               screens = 1;  // operation name
+
+    if ((d == NULL) || (screen_size == 0)) {
+        return 0;
+    }
+    for (f = PIC(d->fields); f->kind != TZ_OPERATION_FIELD_END; f++) {
+        screens += field_min_screens(f, screen_size);
+    }
+    return screens;
+}
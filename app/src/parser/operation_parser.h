@@ -18,7 +18,8 @@
 
 #include "parser_state.h"
 
-#define TZ_UNKNOWN_SIZE 0xFFFFu
+/// Size of operations not known yet, operations must be smaller
+#define TZ_UNKNOWN_SIZE TZ_MAX_OFFSET
 
 /**
  * @brief Initialize a operations parser state
@@ -36,16 +37,35 @@
  *                    operations. Otherwise, it will assume that the
  *                    bytes represent a batch of operations.
  */
-void tz_operation_parser_init(tz_parser_state *state, uint16_t size,
+void tz_operation_parser_init(tz_parser_state *state, uint32_t size,
                               bool skip_magic);
 
 /**
  * @brief Set the operations size
  *
  * @param state: parser state
- * @param size: size of operations
+ * @param size: size of operations, smaller than `TZ_UNKNOWN_SIZE`
  */
-void tz_operation_parser_set_size(tz_parser_state *state, uint16_t size);
+void tz_operation_parser_set_size(tz_parser_state *state, uint32_t size);
+
+#ifdef TZ_OPERATION_CHECKPOINT
+/**
+ * @brief Initialize a operations parser state to parse again a batch
+ *        of operations from one of its operations
+ *
+ *        The checkpoint is the one the parser recorded before the tag
+ *        of the operation (see `tz_operation_state`). The parser must
+ *        then be refilled from the offset of the checkpoint, what was
+ *        parsed before it is not read again.
+ *
+ * @param state: parser state
+ * @param size: size of operations, or `TZ_UNKNOWN_SIZE`
+ * @param checkpoint: checkpoint of the operation
+ */
+void tz_operation_parser_restore(tz_parser_state               *state,
+                                 uint32_t                       size,
+                                 const tz_operation_checkpoint *checkpoint);
+#endif
 
 /**
  * @brief Apply one step to the operations parser
@@ -54,3 +74,42 @@ void tz_operation_parser_set_size(tz_parser_state *state, uint16_t size);
  * @return tz_parser_result: parser result
  */
 tz_parser_result tz_operation_parser_step(tz_parser_state *state);
+
+/**
+ * @brief Apply steps to the operations parser until it is blocked
+ *
+ *        The parser is blocked when it needs more input, when its
+ *        output is full, when it is done or on error.
+ *
+ * @param state: parser state
+ * @param steps: if not NULL, incremented by the number of steps applied
+ * @return tz_parser_result: parser result, always blocking
+ */
+tz_parser_result tz_operation_parser_run(tz_parser_state *state,
+                                         size_t          *steps);
+
+/**
+ * @brief Compute a lower bound of the number of screens needed to
+ *        display the last operation read, from its tag
+ *
+ *        Every field the operation displays whatever its content is
+ *        counted with the shortest value it can have, and the name of
+ *        the operation with one screen. Fields are never displayed on
+ *        the same screen.
+ *
+ * @param state: parser state
+ * @param screen_size: maximum number of characters of a screen
+ * @return size_t: lower bound, 0 if no operation has been read
+ */
+size_t tz_operation_parser_min_screens(const tz_parser_state *state,
+                                       size_t                 screen_size);
+
+#if defined(TEZOS_DEBUG) || defined(TZ_PARSER_COUNTERS)
+/// Human readable names of the operations parser steps
+extern const char *const tz_operation_parser_step_name[];
+#endif
+
+#ifdef TZ_PARSER_COUNTERS
+/// Supported operations, in the order of the `operation_tags` counters
+extern const tz_operation_descriptor tz_operation_descriptors[];
+#endif
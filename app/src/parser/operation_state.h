@@ -42,6 +42,9 @@ typedef enum {
     TZ_OPERATION_TAG_SORU_EXE_MSG = 206
 } tz_operation_tag;
 
+/// Number of operation tags supported, excluding `TZ_OPERATION_TAG_END`
+#define TZ_OPERATION_TAG_COUNT 16
+
 /**
  * @brief Enumeration of all operations parser step
  */
@@ -72,6 +75,9 @@ typedef enum {
     TZ_OPERATION_STEP_READ_PKH_LIST
 } tz_operation_parser_step_kind;
 
+/// Number of operations parser steps
+#define TZ_OPERATION_STEP_COUNT (TZ_OPERATION_STEP_READ_PKH_LIST + 1)
+
 /**
  * @brief Enumeration of all operations fields
  */
@@ -105,6 +111,22 @@ typedef enum {
     TZ_OPERATION_FIELD_BALLOT
 } tz_operation_field_kind;
 
+/**
+ * @brief Hook of the operations parser, called as soon as a
+ *        destination, an amount or a fee is decoded, once the
+ *        operation state is updated with it
+ *
+ *        Lets the caller reject an operation without parsing the rest
+ *        of it.
+ *
+ * @param kind: kind of the field decoded
+ *              TZ_OPERATION_FIELD_DESTINATION
+ *              TZ_OPERATION_FIELD_AMOUNT
+ *              TZ_OPERATION_FIELD_FEE
+ * @return bool: false to reject the operation
+ */
+typedef bool (*tz_operation_hook)(tz_operation_field_kind kind);
+
 struct tz_operation_field_descriptor;
 
 /**
@@ -149,18 +171,19 @@ typedef struct {
  * @brief This struct represents the frame of the parser of operations
  *
  *        A frame contains the next step to be performed and its
- *        corresponding context
+ *        corresponding context. The stop offset shares a 32-bit word
+ *        with the step.
  */
 typedef struct {
-    tz_operation_parser_step_kind step : 5;  /// step
-    uint16_t                      stop;      /// stop offset
+    tz_operation_parser_step_kind step : 5;   /// step
+    uint32_t                      stop : 24;  /// stop offset
     union {
         tz_operation_option_field_descriptor
             step_option;  /// option field
                           /// TZ_OPERATION_STEP_OPTION
         struct {
             uint8_t  size_len;  /// number of bytes to read
-            uint16_t size;      /// current parsed value
+            uint32_t size;      /// current parsed value
         } step_size;            /// TZ_OPERATION_STEP_SIZE
         struct {
             const tz_operation_field_descriptor
@@ -228,6 +251,29 @@ typedef struct {
 
 #define TZ_OPERATION_STACK_DEPTH 6  /// Maximum operations depth handled
 
+#ifdef HAVE_BAGL
+#define TZ_OPERATION_CHECKPOINT  /// record checkpoints, to rewind reviews
+#endif
+
+#ifdef TZ_OPERATION_CHECKPOINT
+/**
+ * @brief This struct represents a checkpoint of the parser of
+ *        operations, taken before the tag of each operation of a batch
+ *
+ *        There, the stack only holds the frame of the batch: the state
+ *        comes down to the offset of the tag and to what is kept from
+ *        one operation to the next and displayed. The fields checked
+ *        by the swap only are left out, swaps are never rewound.
+ */
+typedef struct {
+    uint64_t total_fee;     /// fees of the previous operations
+    uint64_t total_amount;  /// amounts of the previous operations
+    uint32_t ofs;           /// offset of the tag of the operation
+    int      field_index;   /// index of the last field parsed
+    uint16_t batch_index;   /// index of the operation in the batch
+} tz_operation_checkpoint;
+#endif
+
 /**
  * @brief This struct represents the parser of operations
  *
@@ -251,4 +297,11 @@ typedef struct {
 #endif                           // HAVE_SWAP
     uint64_t total_fee;          /// last fee encountered
     uint64_t total_amount;       /// last amount encountered
+    tz_operation_hook hook;      /// hook on decoded fields, can be NULL
+    const tz_operation_descriptor
+        *descriptor;  /// last operation read, NULL before the first one
+#ifdef TZ_OPERATION_CHECKPOINT
+    tz_operation_checkpoint
+        checkpoint;  /// taken before the tag of the last operation read
+#endif
 } tz_operation_state;
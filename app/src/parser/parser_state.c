@@ -49,6 +49,7 @@ tz_parser_result_name(tz_parser_result code)
     TZ_LABEL(ERR_TOO_LARGE);
     TZ_LABEL(ERR_TOO_DEEP);
     TZ_LABEL(ERR_INVALID_STATE);
+    TZ_LABEL(ERR_REJECTED);
     default:
         return "Unknown";
     }
@@ -60,9 +61,13 @@ tz_parser_init(tz_parser_state *state)
 {
     state->errno                       = TZ_CONTINUE;
     state->ofs                         = 0;
+    state->no_render                   = false;
     state->field_info.field_name[0]    = 0;
     state->field_info.is_field_complex = false;
     state->field_info.field_index      = 0;
+#ifdef TZ_PARSER_COUNTERS
+    memset(&state->counters, 0, sizeof(state->counters));
+#endif
 }
 
 void
@@ -99,6 +104,20 @@ tz_parser_refill(tz_parser_state *st, const uint8_t *ibuf, size_t ilen)
     regs->ilen = ilen;
 }
 
+#ifdef TZ_PARSER_COUNTERS
+void
+tz_parser_count(tz_parser_state *state, tz_parser_counter *counter, int ofs,
+                size_t oofs)
+{
+    counter->steps++;
+    counter->bytes += (uint32_t)(state->ofs - ofs);
+    // the output buffer is only flushed between two steps
+    if (state->regs.oofs > oofs) {
+        counter->chars += (uint32_t)(state->regs.oofs - oofs);
+    }
+}
+#endif
+
 tz_parser_result
 tz_parser_set_errno(tz_parser_state *state, tz_parser_result code)
 {
@@ -120,6 +139,25 @@ tz_parser_put(tz_parser_state *state, char c)
     tz_continue;
 }
 
+tz_parser_result
+tz_parser_put_span(tz_parser_state *state, const char *str, size_t *written)
+{
+    tz_parser_regs *regs = &state->regs;
+    size_t          n    = 0;
+
+    while ((n < regs->olen) && (str[n] != '\0')) {
+        n++;
+    }
+    memcpy(regs->obuf + regs->oofs, str, n);
+    regs->oofs += n;
+    regs->olen -= n;
+    *written = n;
+    if (str[n] != '\0') {
+        tz_stop(IM_FULL);
+    }
+    tz_continue;
+}
+
 tz_parser_result
 tz_parser_read(tz_parser_state *state, uint8_t *r)
 {
@@ -134,6 +172,25 @@ tz_parser_read(tz_parser_state *state, uint8_t *r)
     tz_continue;
 }
 
+tz_parser_result
+tz_parser_read_bytes(tz_parser_state *state, uint8_t *out, size_t max,
+                     size_t *read)
+{
+    tz_parser_regs *regs = &state->regs;
+    size_t          n    = (max < regs->ilen) ? max : regs->ilen;
+
+    *read = 0;
+    if (n < 1) {
+        tz_stop(FEED_ME);
+    }
+    memcpy(out, regs->ibuf + regs->iofs, n);
+    state->ofs += (int)n;
+    regs->iofs += n;
+    regs->ilen -= n;
+    *read = n;
+    tz_continue;
+}
+
 tz_parser_result
 tz_parser_peek(tz_parser_state *state, uint8_t *r)
 {
@@ -22,6 +22,15 @@
 #include "micheline_state.h"
 #include "operation_state.h"
 
+/**
+ * @brief Largest offset a parser frame can stop at
+ *
+ *        Parser offsets are 32-bit, but stop offsets are packed on 24
+ *        bits next to the step of each frame: inputs can be up to
+ *        16 MiB long.
+ */
+#define TZ_MAX_OFFSET 0xFFFFFFu
+
 // Parser buffers and buffer handling registers
 
 /**
@@ -69,6 +78,7 @@ typedef enum {
     TZ_ERR_TOO_LARGE     = 204,  /// too large data has been found
     TZ_ERR_TOO_DEEP      = 205,  /// too deep data has been found
     TZ_ERR_INVALID_STATE = 206,  /// parser is in an invalid state
+    TZ_ERR_REJECTED      = 207,  /// the caller rejected the data
 } tz_parser_result;
 
 #define TZ_IS_BLOCKED(code) \
@@ -83,6 +93,39 @@ typedef enum {
  */
 const char *tz_parser_result_name(tz_parser_result code);
 
+#ifdef TZ_PARSER_COUNTERS
+/**
+ * @brief This struct represents the work done by a parser step
+ */
+typedef struct {
+    uint32_t steps;  /// number of steps applied
+    uint32_t bytes;  /// number of input bytes consumed
+    uint32_t chars;  /// number of output characters emitted
+} tz_parser_counter;
+
+/**
+ * @brief This struct represents the parser instrumentation counters.
+ *
+ *        Only compiled in with `TZ_PARSER_COUNTERS`. The work of the
+ *        micheline steps is also accounted in the operations
+ *        `READ_MICHELINE` step which drives them.
+ */
+typedef struct {
+    tz_parser_counter
+        operation_steps[TZ_OPERATION_STEP_COUNT];  /// per operations step
+    tz_parser_counter
+        micheline_steps[TZ_MICHELINE_STEP_COUNT];  /// per micheline step
+    tz_parser_counter
+        operation_tags[TZ_OPERATION_TAG_COUNT
+                       + 1];  /// per operation tag, indexed by the
+                              /// position of the operation descriptor
+                              /// plus one, 0 standing for the data read
+                              /// outside of any operation
+    uint8_t current_tag;      /// index in `operation_tags` of the
+                              /// operation being parsed
+} tz_parser_counters;
+#endif
+
 /**
  * @brief This struct represents the parser state.
  */
@@ -99,6 +142,9 @@ typedef struct {
     } field_info;               /// information of the last field parsed
                                 // common singleton buffers
     int ofs;                    /// offset for the parser
+    bool no_render;  /// only check the input and update the operation
+                     /// totals, print nothing: reset by
+                     /// `tz_parser_init`, set it after
     /// input type specific state
     tz_micheline_state micheline;  /// micheline parser state
     tz_operation_state operation;  /// operation parser state
@@ -108,6 +154,9 @@ typedef struct {
                                                   /// to store string values
     } buffers;
     tz_parser_result errno;  /// current parser result
+#ifdef TZ_PARSER_COUNTERS
+    tz_parser_counters counters;  /// instrumentation counters
+#endif
 } tz_parser_state;
 
 /**
@@ -163,6 +212,23 @@ void tz_parser_skip(tz_parser_state *state);
  */
 tz_parser_result tz_parser_put(tz_parser_state *state, char c);
 
+/**
+ * @brief Put as much of a string as possible at the end of what has
+ *        been parsed
+ *
+ *        Span variant of `tz_parser_put`: copies the characters of
+ *        `str` until its end or until the output buffer is full. The
+ *        caller resumes from `str + *written` after a flush.
+ *
+ * @param state: parser state
+ * @param str: null-terminated string
+ * @param written: number of characters copied
+ * @return tz_parser_result: parser result, IM_FULL if `str` was not
+ *                           entirely copied
+ */
+tz_parser_result tz_parser_put_span(tz_parser_state *state, const char *str,
+                                    size_t *written);
+
 /**
  * @brief Read a bytes
  *
@@ -172,6 +238,22 @@ tz_parser_result tz_parser_put(tz_parser_state *state, char c);
  */
 tz_parser_result tz_parser_read(tz_parser_state *state, uint8_t *out);
 
+/**
+ * @brief Read as many bytes as available, up to a maximum
+ *
+ *        Block-copy variant of `tz_parser_read`: consumes in one call
+ *        every byte the input buffer can provide, without exceeding
+ *        `max`. Stops with FEED_ME only if no byte could be read.
+ *
+ * @param state: parser state
+ * @param out: output buffer
+ * @param max: maximum number of bytes to read
+ * @param read: number of bytes read
+ * @return tz_parser_result: parser result
+ */
+tz_parser_result tz_parser_read_bytes(tz_parser_state *state, uint8_t *out,
+                                      size_t max, size_t *read);
+
 /**
  * @brief Peek a bytes
  *
@@ -181,6 +263,19 @@ tz_parser_result tz_parser_read(tz_parser_state *state, uint8_t *out);
  */
 tz_parser_result tz_parser_peek(tz_parser_state *state, uint8_t *out);
 
+#ifdef TZ_PARSER_COUNTERS
+/**
+ * @brief Account the work done by a step in a counter
+ *
+ * @param state: parser state
+ * @param counter: counter to update
+ * @param ofs: parser offset before the step
+ * @param oofs: output buffer offset before the step
+ */
+void tz_parser_count(tz_parser_state *state, tz_parser_counter *counter,
+                     int ofs, size_t oofs);
+#endif
+
 // error handling utils
 
 /**
@@ -0,0 +1,34 @@
+/* Tezos Ledger application - Line breaking with glyph widths
+
+   Copyright 2025 TriliTech <contact@trili.tech>
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+   http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License. */
+
+#include "ui_glyphs.h"
+
+size_t
+tz_ui_glyphs_fit(const uint8_t widths[TZ_UI_GLYPHS_COUNT], const char *value,
+                 size_t length, size_t max_width)
+{
+    size_t width = 0;
+    size_t n     = 0;
+
+    while (n < length) {
+        width += widths[(uint8_t)value[n]];
+        if (width >= max_width) {
+            break;
+        }
+        n++;
+    }
+    return n;
+}
@@ -0,0 +1,41 @@
+/* Tezos Ledger application - Line breaking with glyph widths
+
+   Copyright 2025 TriliTech <contact@trili.tech>
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+   http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License. */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+/// Number of entries of a glyph-width table: one per Latin-1 character
+#define TZ_UI_GLYPHS_COUNT 256
+
+/**
+ * @brief Compute how many characters of a text fit in a width, in a
+ * single pass over the text.
+ *
+ *        As with `bagl_compute_line_width`, the width of a text is the
+ *        sum of the widths of its characters, so the widths of the
+ *        prefixes only grow and the scan stops at the first character
+ *        that does not fit.
+ *
+ * @param widths: width in pixels of each character of the font
+ * @param value: text to fit
+ * @param length: length of the text
+ * @param max_width: width the text must stay strictly below
+ * @return size_t: length of the longest prefix narrower than max_width
+ */
+size_t tz_ui_glyphs_fit(const uint8_t widths[TZ_UI_GLYPHS_COUNT],
+                        const char *value, size_t length, size_t max_width);
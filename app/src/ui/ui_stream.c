@@ -18,6 +18,7 @@
 
 #include "globals.h"
 #include "exception.h"
+#include "ui_glyphs.h"
 #include "ui_strings.h"
 
 //! Init array consists of TZ_SCREEN_LINES + background + left & right arrow +
@@ -27,14 +28,26 @@
 #define G_stream global.ui.stream
 
 #ifdef HAVE_BAGL
+// the screen displayed and the one built ahead must both fit in the
+// pool, with the slots skipped before a title at the end of the pool
+#if TZ_UI_STRINGS_SLOTS                                                 \
+    < ((2 * (TZ_UI_STRINGS_STRING_SLOTS + TZ_UI_STREAM_CONTENTS_LINES)) \
+       + TZ_UI_STRINGS_STRING_SLOTS - 1)
+#error "The string pool cannot hold two screens"
+#endif
+
 static unsigned int cb(unsigned int button_mask,
                        unsigned int button_mask_counter);
 static const char  *find_icon(tz_ui_icon_t icon);
 static void         pred(void);
 static void         succ(void);
+static void         back_home(void);
 static void         change_screen_left(void);
 static void         change_screen_right(void);
 static void         redisplay(void);
+static void         push_line(const char *text, size_t len, uint8_t *out);
+static const char  *screen_title(size_t bucket);
+static const char  *screen_body(size_t bucket, size_t line);
 
 const bagl_icon_details_t C_icon_rien = {0, 0, 1, NULL, NULL};
 
@@ -84,6 +97,22 @@ succ(void)
 
 // View
 
+/**
+ * @brief Leave the review for the home screen
+ *
+ *        The owner of the stream is told about an error, rejections
+ *        included, through its hook.
+ */
+static void
+back_home(void)
+{
+    if ((global.step == ST_ERROR) && (G_stream.on_error != NULL)) {
+        G_stream.on_error();
+    }
+    global.step = ST_IDLE;
+    ui_home_init();
+}
+
 static unsigned int
 cb(unsigned int                         button_mask,
    __attribute__((unused)) unsigned int button_mask_counter)
@@ -95,6 +124,12 @@ cb(unsigned int                         button_mask,
     FUNC_ENTER(("button_mask=%d, button_mask_counter=%d", button_mask,
                 button_mask_counter));
 
+    // the screen is being pushed again after a rewind
+    if (s->current > s->total) {
+        FUNC_LEAVE();
+        return 0;
+    }
+
     switch (button_mask) {
     case BUTTON_EVT_RELEASED | BUTTON_LEFT:
         change_screen_left();
@@ -107,8 +142,7 @@ cb(unsigned int                         button_mask,
             s->cb(cb_type);
         }
         if (cb_type & TZ_UI_STREAM_CB_MAINMASK) {
-            global.step = ST_IDLE;
-            ui_home_init();
+            back_home();
         }
         break;
     default:
@@ -135,6 +169,26 @@ find_icon(tz_ui_icon_t icon)
     // clang-format on
 }
 
+/* Title of a screen, stored in the pool of strings just before the
+ * body lines */
+static const char *
+screen_title(size_t bucket)
+{
+    return ui_strings_get(G_stream.screens[bucket].first);
+}
+
+/* Body line of a screen, NULL past the last one */
+static const char *
+screen_body(size_t bucket, size_t line)
+{
+    tz_ui_stream_screen_t *screen = &G_stream.screens[bucket];
+
+    if (line >= screen->body_len) {
+        return NULL;
+    }
+    return ui_strings_get(ui_strings_next(screen->first) + line);
+}
+
 static void
 display_init(bagl_element_t init[UI_INIT_ARRAY_LEN])
 {
@@ -143,8 +197,9 @@ display_init(bagl_element_t init[UI_INIT_ARRAY_LEN])
 
     /* If we aren't on the first screen, we can go back */
     if (s->current > 0) {
-        /* Unless we can't... */
-        if (s->current == (s->total - TZ_UI_STREAM_HISTORY_SCREENS + 1)) {
+        /* Unless we can't, the review not being rewindable... */
+        if ((s->current == s->last)
+            && ((s->can_rewind == NULL) || !s->can_rewind())) {
             init[1].text = (const char *)&C_icon_go_forbid;
         } else {
             init[1].text = (const char *)&C_icon_go_left;
@@ -189,27 +244,27 @@ redisplay_screen(tz_ui_layout_type_t layout, uint8_t icon_pos)
          (const char *)&C_icon_rien},
         {{BAGL_LABELINE, 0x02, 8, 8, 112, 11, 0, 0, 0, 0xFFFFFF, 0x000000,
           BOLD, 0},
-         s->screens[bucket].title  },
+         screen_title(bucket)      },
 #ifdef TARGET_NANOS
         {{BAGL_LABELINE, 0x02, 0, 19, 128, 11, 0, 0, 0, 0xFFFFFF, 0x000000,
           REGULAR, 0},
-         s->screens[bucket].body[0]},
+         screen_body(bucket, 0)    },
         {{BAGL_ICON, 0x00, 56, 14, 16, 16, 0, 0, 0, 0xFFFFFF, 0x000000, 0,
           BAGL_GLYPH_NOGLYPH},
          (const char *)&C_icon_rien},
 #else
         {{BAGL_LABELINE, 0x02, 0, 21, 128, 11, 0, 0, 0, 0xFFFFFF, 0x000000,
           REGULAR, 0},
-         s->screens[bucket].body[0]},
+         screen_body(bucket, 0)    },
         {{BAGL_LABELINE, 0x02, 0, 34, 128, 11, 0, 0, 0, 0xFFFFFF, 0x000000,
           REGULAR, 0},
-         s->screens[bucket].body[1]},
+         screen_body(bucket, 1)    },
         {{BAGL_LABELINE, 0x02, 0, 47, 128, 11, 0, 0, 0, 0xFFFFFF, 0x000000,
           REGULAR, 0},
-         s->screens[bucket].body[2]},
+         screen_body(bucket, 2)    },
         {{BAGL_LABELINE, 0x02, 0, 60, 128, 11, 0, 0, 0, 0xFFFFFF, 0x000000,
           REGULAR, 0},
-         s->screens[bucket].body[3]},
+         screen_body(bucket, 3)    },
         {{BAGL_ICON, 0x00, 56, 47, 16, 16, 0, 0, 0, 0xFFFFFF, 0x000000, 0,
           BAGL_GLYPH_NOGLYPH},
          (const char *)&C_icon_rien},
@@ -243,9 +298,9 @@ redisplay_screen(tz_ui_layout_type_t layout, uint8_t icon_pos)
             init[i].component         = init[icon_pos + 1].component;
             init[i].component.font_id = BOLD;
             if (i == (txt_start_line + 1)) {
-                init[i].text = s->screens[bucket].title;
+                init[i].text = screen_title(bucket);
             } else {
-                init[i].text = s->screens[bucket].body[i - 5];
+                init[i].text = screen_body(bucket, i - 5);
             }
             init[i].component.x = 8;
             init[i].component.y
@@ -290,6 +345,11 @@ redisplay(void)
     tz_ui_stream_t *s        = &G_stream;
     size_t          bucket   = s->current % TZ_UI_STREAM_HISTORY_SCREENS;
     uint8_t         icon_pos = UI_INIT_ARRAY_LEN - 1;
+    // after a rewind, the screen displayed stays until the current one
+    // is pushed again
+    if (s->current > s->total) {
+        TZ_SUCCEED();
+    }
     // clang-format off
     redisplay_screen(s->screens[bucket].layout_type, icon_pos);
     // clang-format on
@@ -299,7 +359,19 @@ redisplay(void)
 static void
 change_screen_left(void)
 {
+    tz_ui_stream_t *s = &G_stream;
+
     FUNC_ENTER(("void"));
+    // the previous screen has been dropped, the callback may rewind
+    if ((s->current > 0) && (s->current == s->last)) {
+        s->cb(TZ_UI_STREAM_CB_REWIND);
+
+        if (global.step == ST_ERROR) {
+            back_home();
+            FUNC_LEAVE();
+            return;
+        }
+    }
     pred();
     redisplay();
     FUNC_LEAVE();
@@ -318,8 +390,7 @@ change_screen_right(void)
         PRINTF("[DEBUG] step=%d\n", global.keys.apdu.sign.step);
 
         if (global.step == ST_ERROR) {
-            global.step = ST_IDLE;
-            ui_home_init();
+            back_home();
             return;
         }
     }
@@ -340,6 +411,55 @@ tz_ui_stream_start(void)
     FUNC_LEAVE();
 }
 
+void
+tz_ui_stream_prefetch(void)
+{
+    tz_ui_stream_t *s = &G_stream;
+
+    FUNC_ENTER(("void"));
+    // nothing to build if the next screen is ready or already awaited
+    if ((s->cb != NULL) && !s->full && (s->current == s->total)
+        && !s->pressed_right) {
+        s->cb(TZ_UI_STREAM_CB_PREFETCH);
+
+        if (global.step == ST_ERROR) {
+            back_home();
+        }
+    }
+    FUNC_LEAVE();
+}
+
+int16_t
+tz_ui_stream_next(void)
+{
+    return G_stream.total + 1;
+}
+
+int16_t
+tz_ui_stream_oldest(void)
+{
+    return G_stream.last;
+}
+
+void
+tz_ui_stream_rewind(int16_t screen)
+{
+    tz_ui_stream_t *s = &G_stream;
+
+    FUNC_ENTER(("screen=%d", screen));
+    // dropped strings stay in the pool until overwritten: the screen
+    // displayed is left as it is until the first screen pushed again
+    while (s->last <= s->total) {
+        drop_last_screen();
+    }
+    s->full          = false;
+    s->pressed_right = false;
+    s->total         = screen - 1;
+    s->current       = screen;
+    s->last          = screen;
+    FUNC_LEAVE();
+}
+
 void
 tz_ui_stream(void)
 {
@@ -354,6 +474,28 @@ tz_ui_stream(void)
     FUNC_LEAVE();
 }
 
+#if defined(HAVE_BAGL) && !defined(TARGET_NANOS)
+/* Width of each character in the font of the screen contents, measured
+ * once with the BAGL library so that lines are broken in one pass */
+static uint8_t G_glyph_widths[TZ_UI_GLYPHS_COUNT];
+static bool    G_glyph_widths_measured = false;
+
+static const uint8_t *
+glyph_widths(void)
+{
+    if (!G_glyph_widths_measured) {
+        for (size_t c = 0; c < TZ_UI_GLYPHS_COUNT; c++) {
+            char ch           = (char)c;
+            G_glyph_widths[c] = (uint8_t)bagl_compute_line_width(
+                BAGL_FONT_OPEN_SANS_REGULAR_11px, 0, &ch, 1,
+                BAGL_ENCODING_LATIN1);
+        }
+        G_glyph_widths_measured = true;
+    }
+    return G_glyph_widths;
+}
+#endif
+
 uint8_t
 tz_ui_max_line_chars(const char *value, int length)
 {
@@ -371,22 +513,63 @@ tz_ui_max_line_chars(const char *value, int length)
     will_fit = se_get_cropped_length(value, will_fit, BAGL_WIDTH,
                                      BAGL_ENCODING_LATIN1);
 #elif defined(HAVE_BAGL)
-    uint8_t width;
-    will_fit++;
-    do {
-        width = bagl_compute_line_width(BAGL_FONT_OPEN_SANS_REGULAR_11px, 0,
-                                        value, --will_fit,
-                                        BAGL_ENCODING_LATIN1);
-    } while (width >= BAGL_WIDTH);
-
-    PRINTF("[DEBUG] max_line_width(value: \"%s\", width: %d, will_fit: %d)\n",
-           value, width, will_fit);
+    will_fit = (uint8_t)tz_ui_glyphs_fit(glyph_widths(), value, will_fit,
+                                         BAGL_WIDTH);
+
+    PRINTF("[DEBUG] max_line_width(value: \"%s\", will_fit: %d)\n", value,
+           will_fit);
 #endif
 
     FUNC_LEAVE();
     return will_fit;
 }
 
+/* Skip the newline ending the previous line, if any, and return how
+ * many characters of the next line fit on the screen */
+static uint8_t
+next_line(const char *value, size_t length, size_t *offset)
+{
+    if (value[*offset] == '\n') {
+        (*offset)++;
+    }
+    return tz_ui_max_line_chars(&value[*offset], length - *offset);
+}
+
+size_t
+tz_ui_stream_fit(const char *value)
+{
+    size_t length = strlen(value);
+    size_t offset = 0;
+    short  line   = 0;
+
+    while ((offset < length) && (line < TZ_UI_STREAM_CONTENTS_LINES)) {
+        uint8_t will_fit = next_line(value, length, &offset);
+        offset += will_fit;
+        line++;
+    }
+    return offset;
+}
+
+/* Push a title or a body line after the newest one in the pool of
+ * strings, dropping the oldest screens until it fits */
+static void
+push_line(const char *text, size_t len, uint8_t *out)
+{
+    bool can_fit = false;
+
+    TZ_PREAMBLE(("%s", text));
+
+    TZ_CHECK(ui_strings_can_fit(len, &can_fit));
+    while (!can_fit) {
+        TZ_CHECK(drop_last_screen());
+        TZ_CHECK(ui_strings_can_fit(len, &can_fit));
+    }
+
+    TZ_CHECK(ui_strings_push(text, len, out));
+
+    TZ_POSTAMBLE;
+}
+
 /* pushl mechanism */
 size_t
 tz_ui_stream_pushl(tz_ui_cb_type_t cb_type, const char *title,
@@ -409,7 +592,7 @@ tz_ui_stream_pushl(tz_ui_cb_type_t cb_type, const char *title,
     s->total++;
     int bucket = s->total % TZ_UI_STREAM_HISTORY_SCREENS;
 
-    if ((s->total > 0)
+    if ((s->total > s->current)
         && (s->current % TZ_UI_STREAM_HISTORY_SCREENS) == bucket) {
         PRINTF(
             "[ERROR] PANIC!!!! Overwriting current screen, some bad things "
@@ -417,12 +600,14 @@ tz_ui_stream_pushl(tz_ui_cb_type_t cb_type, const char *title,
     }
 
     /* drop the previous screen text in our bucket */
-    if ((s->total > 0)
+    if ((s->total > s->last)
         && (bucket == (s->last % TZ_UI_STREAM_HISTORY_SCREENS))) {
         drop_last_screen();
     }
 
-    push_str(title, strlen(title), &s->screens[bucket].title);
+    // the title and body lines are pushed in consecutive slots of the
+    // pool, dropping older screens does not move the end of the pool
+    push_line(title, strlen(title), &s->screens[bucket].first);
 
     // Ensure things fit on one line
     size_t length = strlen(value);
@@ -438,20 +623,14 @@ tz_ui_stream_pushl(tz_ui_cb_type_t cb_type, const char *title,
 
     short line = 0;
     while ((offset < length) && (line < TZ_UI_STREAM_CONTENTS_LINES)) {
-        uint8_t will_fit;
-
-        if (value[offset] == '\n') {
-            offset++;
-        }
-
-        will_fit = tz_ui_max_line_chars(&value[offset], length - offset);
+        uint8_t will_fit = next_line(value, length, &offset);
 
         PRINTF(
             "[DEBUG] split(value: \"%s\", will_fit: %d, line: %d, "
             "offset: %d)\n",
             &value[offset], will_fit, line, offset);
 
-        push_str(&value[offset], will_fit, &s->screens[bucket].body[line]);
+        push_line(&value[offset], will_fit, NULL);
 
         offset += will_fit;
 
@@ -461,14 +640,10 @@ tz_ui_stream_pushl(tz_ui_cb_type_t cb_type, const char *title,
 
     PRINTF("[DEBUG] tz_ui_stream_pushl(%s, %s, %u)\n", title, value, max);
     PRINTF("[DEBUG]        bucket     %d\n", bucket);
-    PRINTF("[DEBUG]        title:     \"%s\"\n", s->screens[bucket].title);
-    for (line = 0; line < TZ_UI_STREAM_CONTENTS_LINES; line++) {
-        if (s->screens[bucket].body[line]) {
-            PRINTF("[DEBUG]        value[%d]:  \"%s\"\n", line,
-                   s->screens[bucket].body[line]);
-        } else {
-            PRINTF("[DEBUG]        value[%d]:  \"\"\n", line);
-        }
+    PRINTF("[DEBUG]        title:     \"%s\"\n", screen_title(bucket));
+    for (line = 0; line < s->screens[bucket].body_len; line++) {
+        PRINTF("[DEBUG]        value[%d]:  \"%s\"\n", line,
+               screen_body(bucket, line));
     }
     PRINTF("[DEBUG]        total:     %d -> %d\n", prev_total, s->total);
     PRINTF("[DEBUG]        current:   %d -> %d\n", prev_current, s->current);
@@ -487,15 +662,10 @@ drop_last_screen(void)
 
     TZ_PREAMBLE(("last: %d", s->last));
 
-    size_t i;
-    if (s->screens[bucket].title) {
-        TZ_CHECK(ui_strings_drop(&s->screens[bucket].title));
-    }
-    for (i = 0; i < TZ_UI_STREAM_CONTENTS_LINES; i++) {
-        if (s->screens[bucket].body[i]) {
-            TZ_CHECK(ui_strings_drop(&s->screens[bucket].body[i]));
-        }
-    }
+    // the oldest strings of the pool are the title and body lines of
+    // the last screen
+    TZ_CHECK(ui_strings_drop_to(ui_strings_next(s->screens[bucket].first)
+                                + s->screens[bucket].body_len));
     s->last++;
 
     TZ_POSTAMBLE;
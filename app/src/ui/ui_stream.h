@@ -26,11 +26,12 @@
 
    When a new page is needed, the display will call the `refill`
    callback, which in turn can call `tz_ui_stream_push` to add a new
-   page. When the last page is reached, `tz_ui_stream_close` should be
-   called, and the two final special pages to `accept` and `reject`
-   the operation are pushed. The user can trigger the `accept` and
-   `reject` callbacks by pressing both buttons while there pages are
-   displayed.
+   page. On idle time, `tz_ui_stream_prefetch` lets the callback push
+   the next page ahead, before the user asks for it. When the last
+   page is reached, `tz_ui_stream_close` should be called, and the two
+   final special pages to `accept` and `reject` the operation are
+   pushed. The user can trigger the `accept` and `reject` callbacks
+   by pressing both buttons while there pages are displayed.
 
    It is also possible to use this display engine for non streamed
    data by pushing a precomputed series of pages with
@@ -45,13 +46,14 @@
 
 #include "ui_strings.h"
 
-#ifdef TARGET_NANOS
-#define TZ_UI_STREAM_HISTORY_SCREENS \
-    5  /// Max number of screens in history for nanos
+#ifdef HAVE_BAGL
+/// Max number of screens in history for nano devices: as many as the
+/// pool of strings can keep.
+#define TZ_UI_STREAM_HISTORY_SCREENS TZ_UI_STRINGS_SCREENS
 #else
 #define TZ_UI_STREAM_HISTORY_SCREENS \
-    8   /// Max number of screens in history for nanos2/nanox.
-#endif  // TARGET_NANOS
+    8  /// Max number of screens in history for stax/flex.
+#endif  // HAVE_BAGL
 
 #define TZ_UI_STREAM_TITLE_WIDTH TZ_SCREEN_WITDH_BETWEEN_ICONS_BOLD_11PX
 
@@ -86,6 +88,10 @@ typedef uint8_t tz_ui_cb_type_t;
 #endif
 #define TZ_UI_STREAM_CB_BLINDSIGN          0x0Eu
 #define TZ_UI_STREAM_CB_VALIDATE           0x0Fu
+#ifdef HAVE_BAGL
+#define TZ_UI_STREAM_CB_REWIND   0xEDu
+#define TZ_UI_STREAM_CB_PREFETCH 0xEEu
+#endif
 #define TZ_UI_STREAM_CB_REFILL             0xEFu
 #define TZ_UI_STREAM_CB_MAINMASK           0xF0u
 #define TZ_UI_STREAM_CB_EXPERT_MODE_FIELD  0xFAu
@@ -146,9 +152,8 @@ typedef struct {
         layout_type;   /// Layout type for the screen. CAN BP, BNP, NP, PB or
                        /// HOME_X where X can be one of the BP, BNP, PB.
     uint8_t body_len;  /// number of non-empty lines in the body.
-    char   *title;     /// Title to display on the screen.
-    char   *body[TZ_UI_STREAM_CONTENTS_LINES];  /// Body to display on the
-                                                /// screen (Below title).
+    uint8_t first;     /// slot of the title in the pool of strings, the
+                       /// body lines follow it.
 #else
     nbgl_layoutTagValue_t
         pairs[NB_MAX_DISPLAYED_PAIRS_IN_REVIEW];  /// Title-value pairs to be
@@ -182,14 +187,19 @@ typedef struct {
     tz_ui_stream_screen_t
         screens[TZ_UI_STREAM_HISTORY_SCREENS];  // array containing info of
                                                 // all screens.
-    tz_ui_strings_t strings;  // Ring buffer containing text data to be
-                              // displayed on screen.
+    tz_ui_strings_t strings;  // Strings of the screens: slot pool on
+                              // BAGL, ring buffer otherwise.
     int16_t current;          // index of current screen.
     int16_t total;            // total number of screens.
     int16_t last;             // index of last screen.
     bool    full;             // true if history is full.
     bool    pressed_right;    // true if right button was pressed.
     tz_ui_stream_display_t current_screen;  // current screen's values.
+    void (*on_error)(void);  // called when an error ends the stream.
+#ifdef HAVE_BAGL
+    bool (*can_rewind)(void);  // whether going back from the oldest
+                               // screen kept rewinds the stream.
+#endif
 #ifdef HAVE_NBGL
     nbgl_callback_t
         stream_cb;  // callback to be called when new screen is needed.
@@ -198,6 +208,25 @@ typedef struct {
 
 void tz_ui_stream_init(void (*cb)(tz_ui_cb_type_t cb_type));
 
+/**
+ * @brief Set the hook called when an error ends the stream, before
+ * going back to the home screen. Reset by `tz_ui_stream_init`.
+ *
+ * @param on_error: the hook, NULL for none
+ */
+void tz_ui_stream_set_error_hook(void (*on_error)(void));
+
+#ifdef HAVE_BAGL
+/**
+ * @brief Set the hook telling whether going back from the oldest
+ * screen kept rewinds the stream, the callback being then called with
+ * TZ_UI_STREAM_CB_REWIND. Reset by `tz_ui_stream_init`.
+ *
+ * @param can_rewind: the hook, NULL if the stream never rewinds
+ */
+void tz_ui_stream_set_rewind_hook(bool (*can_rewind)(void));
+#endif
+
 /**
  * @brief  Push title & content to a single screen
  * content may not always fit on screen entirely - returns total
@@ -236,6 +265,18 @@ size_t tz_ui_stream_pushl(tz_ui_cb_type_t cb_type, const char *title,
                           const char *value, ssize_t max,
                           tz_ui_layout_type_t layout_type, tz_ui_icon_t icon);
 
+#ifdef HAVE_BAGL
+/**
+ * @brief  Compute how much of a value a single screen displays, without
+ * pushing anything: the number of characters `tz_ui_stream_push` would
+ * return for it.
+ *
+ * @param value text to be displayed.
+ * @return size_t  size of content that fits on one screen.
+ */
+size_t tz_ui_stream_fit(const char *value);
+#endif
+
 /**
  * @brief  Push title- value pair, internally calls tz_ui_stream_push multiple
  * times so that entire value is pushed, even if it takes multiple screens.
@@ -271,6 +312,40 @@ void tz_ui_stream(void);
  */
 void tz_ui_stream_start(void);
 
+#ifdef HAVE_BAGL
+/**
+ * @brief Build the next screen ahead, while the user reads the last one
+ * pushed, by calling the callback with TZ_UI_STREAM_CB_PREFETCH. Called
+ * on idle time: the right button then only displays the screen built.
+ *
+ */
+void tz_ui_stream_prefetch(void);
+
+/**
+ * @brief Index of the next screen pushed, the first screen of the
+ * stream being 0.
+ *
+ * @return int16_t  index of the next screen.
+ */
+int16_t tz_ui_stream_next(void);
+
+/**
+ * @brief Index of the oldest screen kept in the history. When the user
+ * goes back past it, the callback is called with TZ_UI_STREAM_CB_REWIND.
+ *
+ * @return int16_t  index of the oldest screen.
+ */
+int16_t tz_ui_stream_oldest(void);
+
+/**
+ * @brief Forget the screens from an older screen on, to push them again:
+ * the buttons are ignored until the screen is pushed and displayed.
+ *
+ * @param screen index of the screen, as returned by tz_ui_stream_next.
+ */
+void tz_ui_stream_rewind(int16_t screen);
+#endif
+
 /**
  * @brief Get the callback type for current screen.
  *
@@ -299,4 +374,6 @@ void switch_to_blindsigning_on_error(void);
 
 void drop_last_screen(void);
 
+#ifdef HAVE_NBGL
 void push_str(const char *text, size_t len, char **out);
+#endif
@@ -50,6 +50,20 @@ tz_ui_stream_push(tz_ui_cb_type_t cb_type, const char *title,
     return tz_ui_stream_pushl(cb_type, title, value, -1, layout_type, icon);
 }
 
+void
+tz_ui_stream_set_error_hook(void (*on_error)(void))
+{
+    G_stream.on_error = on_error;
+}
+
+#ifdef HAVE_BAGL
+void
+tz_ui_stream_set_rewind_hook(bool (*can_rewind)(void))
+{
+    G_stream.can_rewind = can_rewind;
+}
+#endif
+
 tz_ui_cb_type_t
 tz_ui_stream_get_cb_type(void)
 {
@@ -59,6 +73,7 @@ tz_ui_stream_get_cb_type(void)
     return s->screens[bucket].cb_type;
 }
 
+#ifdef HAVE_NBGL
 void
 push_str(const char *text, size_t len, char **out)
 {
@@ -76,6 +91,7 @@ push_str(const char *text, size_t len, char **out)
 
     TZ_POSTAMBLE;
 }
+#endif
 
 void
 tz_ui_stream_close(void)
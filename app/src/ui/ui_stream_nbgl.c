@@ -341,6 +341,9 @@ tz_ui_nav_cb(void)
     }
 
     if (global.step == ST_ERROR) {
+        if (s->on_error != NULL) {
+            s->on_error();
+        }
         global.step = ST_IDLE;
         ui_home_init();
         result = false;
@@ -26,6 +26,131 @@
 #define UI_STRINGS &global.ui.stream.strings
 #endif
 
+#ifdef HAVE_BAGL
+/* Prototypes */
+void        ui_strings_init(void);
+void        ui_strings_push(const char *str, size_t len, uint8_t *out);
+void        ui_strings_drop_to(size_t slot);
+void        ui_strings_can_fit(size_t len, bool *can_fit);
+uint8_t     ui_strings_next(size_t slot);
+const char *ui_strings_get(size_t slot);
+
+#define SLOT(_s, _slot) \
+    (&(_s)->slots[((_slot) % TZ_UI_STRINGS_SLOTS) * TZ_UI_STRINGS_SLOT_SIZE])
+
+/* Number of slots taken by a string of len characters */
+static size_t
+string_slots(size_t len)
+{
+    return MIN(1 + (len / TZ_UI_STRINGS_SLOT_SIZE),
+               TZ_UI_STRINGS_STRING_SLOTS);
+}
+
+/* Slot following the newest string */
+static size_t
+end_slot(void)
+{
+    tz_ui_strings_t *s = UI_STRINGS;
+
+    return (s->first + s->count) % TZ_UI_STRINGS_SLOTS;
+}
+
+/* Number of slots skipped before a string taking `slots` slots, so
+ * that it does not wrap around the end of the pool */
+static size_t
+padding(size_t slots)
+{
+    size_t end = end_slot();
+
+    if ((end + slots) > TZ_UI_STRINGS_SLOTS) {
+        return TZ_UI_STRINGS_SLOTS - end;
+    }
+    return 0;
+}
+
+/* Definitions */
+void
+ui_strings_init(void)
+{
+    tz_ui_strings_t *s = UI_STRINGS;
+
+    memset(s->slots, '\0', sizeof(s->slots));
+    s->first = 0;
+    s->count = 0;
+}
+
+void
+ui_strings_can_fit(size_t len, bool *can_fit)
+{
+    tz_ui_strings_t *s     = UI_STRINGS;
+    size_t           slots = string_slots(len);
+
+    *can_fit = ((s->count + padding(slots) + slots) <= TZ_UI_STRINGS_SLOTS);
+}
+
+void
+ui_strings_push(const char *in, size_t len, uint8_t *out)
+{
+    tz_ui_strings_t *s     = UI_STRINGS;
+    size_t           slots = string_slots(len);
+    size_t           pad   = padding(slots);
+    TZ_PREAMBLE(("'%s' | in=%p, len=%d, first=%d, count=%d", in, in, len,
+                 s->first, s->count));
+
+    /* Preconditions */
+    TZ_ASSERT_NOTNULL(in);
+    TZ_ASSERT(EXC_MEMORY_ERROR,
+              ((s->count + pad + slots) <= TZ_UI_STRINGS_SLOTS));
+
+    // the padding slots are left as they are, no string refers to them
+    s->count = (uint8_t)(s->count + pad);
+    uint8_t slot = (uint8_t)end_slot();
+    strlcpy(SLOT(s, slot), in,
+            MIN(len + 1, slots * TZ_UI_STRINGS_SLOT_SIZE));
+    s->count = (uint8_t)(s->count + slots);
+    if (out != NULL) {
+        *out = slot;
+    }
+
+    PRINTF("[DEBUG] Pushed '%s' to %p\n", SLOT(s, slot), SLOT(s, slot));
+
+    TZ_POSTAMBLE;
+}
+
+uint8_t
+ui_strings_next(size_t slot)
+{
+    tz_ui_strings_t *s = UI_STRINGS;
+
+    return (uint8_t)((slot + string_slots(strlen(SLOT(s, slot))))
+                     % TZ_UI_STRINGS_SLOTS);
+}
+
+const char *
+ui_strings_get(size_t slot)
+{
+    tz_ui_strings_t *s = UI_STRINGS;
+
+    return SLOT(s, slot);
+}
+
+void
+ui_strings_drop_to(size_t slot)
+{
+    tz_ui_strings_t *s = UI_STRINGS;
+    size_t           count
+        = ((slot % TZ_UI_STRINGS_SLOTS) + TZ_UI_STRINGS_SLOTS - s->first)
+          % TZ_UI_STRINGS_SLOTS;
+    TZ_PREAMBLE(("slot=%d, first=%d, count=%d", slot, s->first, s->count));
+
+    TZ_ASSERT(EXC_MEMORY_ERROR, (count <= s->count));
+
+    s->first = (uint8_t)((s->first + count) % TZ_UI_STRINGS_SLOTS);
+    s->count = (uint8_t)(s->count - count);
+
+    TZ_POSTAMBLE;
+}
+#else
 #define BUFF_START ((char *)(s->buffer))
 #define BUFF_END   ((char *)(s->buffer) + BUFF_LEN)
 
@@ -406,3 +531,4 @@ ui_strings_print(void)
     }
 }
 #endif
+#endif  // HAVE_BAGL
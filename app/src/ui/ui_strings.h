@@ -16,6 +16,114 @@
 
 #pragma once
 
+#ifdef HAVE_BAGL
+/**
+ * @brief This file implements a pool of fixed-size slots to store the
+ * strings to be displayed on the ledger screen. On BAGL devices, these
+ * strings are the titles and body lines of the screens: a body line
+ * fits in one slot, a title longer than a line spills over the next
+ * one. The slots are used as a ring: the strings of a screen are
+ * pushed after the newest one and screens are dropped from the oldest
+ * one, so pushing and dropping take constant time.
+ *
+ */
+
+/// Size of a slot: one line of the screen and its null terminator
+#define TZ_UI_STRINGS_SLOT_SIZE (TZ_SCREEN_WITDH_FULL_REGULAR_11PX + 1)
+
+/// Most slots a string takes: titles are kept up to 39 characters,
+/// more than any title pushed (field names with their index, fixed
+/// titles of the review)
+#define TZ_UI_STRINGS_STRING_SLOTS 2
+
+/// Least number of slots of a screen: its title and one body line
+#define TZ_UI_STRINGS_SCREEN_SLOTS 2
+
+/**
+ * Number of screens kept in history: each one takes at least
+ * TZ_UI_STRINGS_SCREEN_SLOTS slots, the pool has that many for each of
+ * them. Compared to the former byte rings, a full screen having a
+ * title of a line and full body lines:
+ * - nanos: 5 screens, full ones included (2 slots each). The 114-byte
+ *   ring kept 5 screens at most, 2 full ones (40 bytes each). The pool
+ *   and history take 227 bytes, 37 more.
+ * - nanos2/nanox: 10 screens of one body line, 4 full ones (5 slots
+ *   each). The 256-byte ring kept 8 screens at most, 2 full ones (100
+ *   bytes each). The pool and history take 452 bytes, 12 less.
+ */
+#ifdef TARGET_NANOS
+#define TZ_UI_STRINGS_SCREENS 5
+#else
+#define TZ_UI_STRINGS_SCREENS 10
+#endif
+
+/// Number of slots
+#define TZ_UI_STRINGS_SLOTS \
+    (TZ_UI_STRINGS_SCREEN_SLOTS * TZ_UI_STRINGS_SCREENS)
+
+/**
+ * @brief This struct represents the pool of slots storing the titles and
+ * body lines to be displayed on the ledger device screens.
+ *
+ */
+typedef struct {
+    char slots[TZ_UI_STRINGS_SLOTS
+               * TZ_UI_STRINGS_SLOT_SIZE];  /// Stores the strings, a
+                                            /// string starting at the
+                                            /// start of a slot
+    uint8_t first;  /// Slot of the oldest string in the pool
+    uint8_t count;  /// Number of slots used in the pool
+} tz_ui_strings_t;
+
+/**
+ * @brief Empties the pool
+ */
+void ui_strings_init(void);
+
+/**
+ * @brief Push a new string after the newest one in the pool. A string
+ * longer than a slot takes the following one too, the slots left at
+ * the end of the pool being skipped to keep them consecutive.
+ *          Throws error if no slot is free. Therefore, it is important to
+ * call ui_strings_can_fit before pushing the string on the pool.
+ *
+ * @param str: ptr to string to copy into the pool
+ * @param len: number of of chars to copy, truncated to the size of
+ * TZ_UI_STRINGS_STRING_SLOTS slots. len <= strlen(str)
+ * @param out: set to the slot of the string, if not NULL
+ */
+void ui_strings_push(const char *str, size_t len, uint8_t *out);
+/**
+ * @brief Slot following the string stored in a slot.
+ *
+ * @param slot slot of the string.
+ * @return uint8_t the slot following the string.
+ */
+uint8_t ui_strings_next(size_t slot);
+/**
+ * @brief String stored in a slot.
+ *
+ * @param slot slot of the string, taken modulo the number of slots.
+ * @return const char* the string.
+ */
+const char *ui_strings_get(size_t slot);
+/**
+ * @brief Drop the oldest strings of the pool, up to a slot.
+ *
+ * @param slot first slot kept, taken modulo the number of slots.
+ */
+void ui_strings_drop_to(size_t slot);
+/**
+ * @brief Checks if the pool can fit the string of length len, without
+ * deleting any existing strings.
+ *
+ * @param len Length of string.
+ * @param can_fit result of the check, true if enough slots are free,
+ * false otherwise.
+ */
+void ui_strings_can_fit(size_t len, bool *can_fit);
+
+#else
 /**
  * @brief This file implements ring buffer to store the strings to be
  * displayed on the ledger screen. The ring buffer is fixed in size and
@@ -26,13 +134,7 @@
  *
  */
 
-#ifdef TARGET_NANOS
-#define BUFF_LEN 114  /// Ring buffer length of nanos
-#elif defined(HAVE_BAGL)
-#define BUFF_LEN 256  /// Ring buffer length for nanos2/nanox
-#else
 #define BUFF_LEN 512  /// Ring buffer length for stax
-#endif
 
 /**
  * @brief This struct represents the ring buffer to store title-value pairs to
@@ -102,3 +204,4 @@ void ui_strings_can_fit(size_t len, bool *can_fit);
  * @return size_t Number of chars appended.
  */
 size_t ui_strings_append_last(const char *str, size_t max, char **out);
+#endif  // HAVE_BAGL
@@ -0,0 +1,132 @@
+#!/usr/bin/env python3
+# Copyright 2025 Trilitech <contact@trili.tech>
+
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+
+# http://www.apache.org/licenses/LICENSE-2.0
+
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""Gathering of tests related to the dry-run parsing."""
+
+from struct import unpack
+
+import pytest
+
+from ledgered.devices import Device
+
+from utils.account import Account
+from utils.backend import Index, Ins, StatusCode, TezosBackend
+from utils.message import RawMessage, Transaction
+from utils.navigator import TezosNavigator
+
+PARSE_DONE = 0x64
+PARSE_FEED_ME = 0x65
+PARSE_INVALID_TAG = 0xC8
+
+# Screens, fields, operations, amount, fee and parser result
+PARSE_RESULT_FORMAT = '>IIHQQB'
+
+# Operation (0): Transaction
+# Source: tz2JPgTWZZpxZZLqHMfS69UAy1UHm4Aw5iHu
+# Fee: 0.05 XTZ
+# Gas limit: 54
+# Counter: 8
+# Storage limit: 45
+# Amount: 0.24 XTZ
+# Destination: KT18amZmM5W7qDWVt2pH6uj7sCEd3kbzLrHT
+# Entrypoint: do
+# Parameter: CAR
+TRANSACTION = "0300000000000000000000000000000000000000000000000000000000000000006c016e8874874d31c3fbd636e924d5a036a43ec8faa7d0860308362d80d30e01000000000000000000000000000000000000000000ff02000000020316"
+
+
+@pytest.mark.parametrize("apdu_size", [235, 10])
+def test_parse_operation(backend: TezosBackend,
+                         device: Device,
+                         apdu_size: int):
+    """Check the result of the parsing of a transaction."""
+
+    data = backend.parse_operation(RawMessage(TRANSACTION),
+                                   apdu_size=apdu_size)
+
+    (screens, fields, batch_index, amount, fee, result) = \
+        unpack(PARSE_RESULT_FORMAT, data)
+
+    assert result == PARSE_DONE, f"Unexpected result {result:#x}"
+    assert batch_index == 1
+    assert amount == 240000
+    assert fee == 50000
+    # Source, fee, storage limit, amount, destination, entrypoint
+    # and parameter at least
+    assert fields >= 7, f"Unexpected number of fields {fields}"
+    if device.is_nano:
+        assert screens >= fields, f"Unexpected number of screens {screens}"
+    else:
+        assert screens == 0, f"Unexpected number of screens {screens}"
+
+    # the application is back to idle
+    backend.version()
+
+
+@pytest.mark.parametrize(
+    "raw_msg, expected_result", [
+        # unknown operation tag
+        ("03000000000000000000000000000000000000000000000000000000000000000001016e8874874d31c3fbd636e924d5a036a43ec8faa7d0860308362d80d30e01000000000000000000000000000000000000000000ff02000000020316",
+         PARSE_INVALID_TAG),
+        # last byte removed
+        (TRANSACTION[:-2], PARSE_FEED_ME),
+    ],
+    ids=["unknown_operation", "truncated"]
+)
+def test_parse_operation_error(backend: TezosBackend,
+                               raw_msg: str,
+                               expected_result: int):
+    """Check the result of the parsing of an invalid operation."""
+
+    data = backend.parse_operation(RawMessage(raw_msg))
+
+    (_, _, _, _, _, result) = unpack(PARSE_RESULT_FORMAT, data)
+
+    assert result == expected_result, f"Unexpected result {result:#x}"
+
+    backend.version()
+
+
+def test_parse_operation_abandoned(backend: TezosBackend,
+                                   tezos_navigator: TezosNavigator,
+                                   account: Account):
+    """Check an abandoned parsing does not prevent signing, and leaves
+    nothing behind for the next parsing."""
+
+    expected = backend.parse_operation(RawMessage(TRANSACTION))
+
+    # the parsing waits for the rest of the message
+    data = backend._exchange(Ins.PARSE_OPERATION, Index.FIRST,
+                             sig_type=0, payload=bytes.fromhex(TRANSACTION[:20]))
+    assert not data, f"No data expected but got {data.hex()}"
+
+    message = Transaction()
+
+    with backend.sign(account, message, with_hash=True) as result:
+        tezos_navigator.accept_sign()
+
+    account.check_signature(
+        message=message,
+        with_hash=True,
+        data=result.value
+    )
+
+    # the abandoned parsing cannot be continued
+    with StatusCode.UNEXPECTED_STATE.expected():
+        backend._exchange(Ins.PARSE_OPERATION, Index.OTHER,
+                          sig_type=0, payload=bytes.fromhex(TRANSACTION[20:]))
+
+    # a new parsing starts afresh
+    data = backend.parse_operation(RawMessage(TRANSACTION))
+    assert data == expected, f"Unexpected result {data.hex()}"
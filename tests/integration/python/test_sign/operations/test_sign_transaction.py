@@ -16,7 +16,10 @@
 
 """Gathering of tests related to Transaction operations."""
 
+from utils.account import Account
+from utils.backend import TezosBackend
 from utils.message import Transaction
+from utils.navigator import TezosNavigator
 from .helper import Flow, Field, TestOperation, pytest_generate_tests
 
 
@@ -49,17 +52,6 @@ class TestTransaction(TestOperation):
         Flow('stake', amount=1000000000, entrypoint='stake'),
         Flow('unstake', amount=500000000, entrypoint='unstake'),
         Flow('finalize_unstake', entrypoint='finalize_unstake'),
-        Flow(
-            'delegate_parameters',
-            entrypoint='delegate_parameters',
-            parameter={'prim': 'Pair', 'args': [
-                {'int': 4000000},
-                {'prim': 'Pair', 'args': [
-                    {'int': 20000000},
-                    {'prim': 'Unit'}
-                ]}
-            ]}
-        ),
     ]
 
     fields = [
@@ -99,3 +91,45 @@ class TestTransaction(TestOperation):
             # More test about Micheline in micheline tests
         ]),
     ]
+
+    def test_delegate_parameters(
+            self,
+            backend: TezosBackend,
+            tezos_navigator: TezosNavigator,
+            account: Account
+    ):
+        """Check the right comb of the delegate parameters is displayed
+        flat: Pair 4000000 20000000 Unit"""
+
+        message = Transaction(
+            entrypoint='delegate_parameters',
+            parameter={'prim': 'Pair', 'args': [
+                {'int': 4000000},
+                {'prim': 'Pair', 'args': [
+                    {'int': 20000000},
+                    {'prim': 'Unit'}
+                ]}
+            ]}
+        )
+
+        tezos_navigator.toggle_expert_mode()
+
+        with backend.sign(account, message) as result:
+            tezos_navigator.navigate_forward(
+                text="Parameter",
+                screen_change_before_first_instruction=True,
+                screen_change_after_last_instruction=False
+            )
+            assert backend.compare_screen_with_text(r"^Pair 4000000"), \
+                "The parameter should be displayed"
+            assert not backend.compare_screen_with_text(r".*\("), \
+                "The nested pair should be printed flat"
+            tezos_navigator.accept_sign(
+                screen_change_before_first_instruction=False
+            )
+
+        account.check_signature(
+            message=message,
+            with_hash=False,
+            data=result.value
+        )
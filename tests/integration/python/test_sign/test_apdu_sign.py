@@ -130,3 +130,62 @@ def test_sign_with_small_packet(
         with_hash=False,
         data=result.value
     )
+
+@pytest.mark.parametrize("with_hash", [True, False])
+def test_sign_in_session(
+        backend: TezosBackend,
+        tezos_navigator: TezosNavigator,
+        account: Account,
+        with_hash: bool
+):
+    """Check signing several messages sending the path once"""
+
+    messages = [
+        Transaction(counter=1),
+        Transaction(counter=2, amount=1_000_000),
+        Transaction(counter=3, amount=2_000_000),
+    ]
+
+    with backend.sign(account,
+                      messages[0],
+                      with_hash=with_hash,
+                      open_session=True) as result:
+        tezos_navigator.accept_sign()
+
+    account.check_signature(
+        message=messages[0],
+        with_hash=with_hash,
+        data=result.value
+    )
+
+    # The second message is sent in several packets
+    for message, apdu_size in [(messages[1], 10), (messages[2], 235)]:
+        with backend.sign_in_session(account,
+                                     message,
+                                     with_hash=with_hash,
+                                     apdu_size=apdu_size) as result:
+            tezos_navigator.accept_sign()
+
+        account.check_signature(
+            message=message,
+            with_hash=with_hash,
+            data=result.value
+        )
+
+def test_reject_closes_session(
+        backend: TezosBackend,
+        tezos_navigator: TezosNavigator,
+        account: Account
+):
+    """Check a rejection closes the signing session"""
+
+    with backend.sign(account, Transaction(counter=1), open_session=True):
+        tezos_navigator.accept_sign()
+
+    with StatusCode.REJECT.expected():
+        with backend.sign_in_session(account, Transaction(counter=2)):
+            tezos_navigator.reject_sign()
+
+    with StatusCode.REFERENCED_DATA_NOT_FOUND.expected():
+        with backend.sign_in_session(account, Transaction(counter=3)):
+            pass
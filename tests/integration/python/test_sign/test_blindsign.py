@@ -17,12 +17,11 @@
 """Gathering of tests related to Blindsign."""
 
 from pathlib import Path
-from typing import List, Union
 
 import pytest
 
 from ledgered.devices import Device, DeviceType
-from ragger.navigator import NavIns, NavInsID
+from ragger.navigator import NavInsID
 
 from utils.account import Account
 from utils.backend import TezosBackend, StatusCode
@@ -35,7 +34,8 @@ from utils.message import (
     Delegation,
     RegisterGlobalConstant,
     SetDepositLimit,
-    ScRollupAddMessage
+    ScRollupAddMessage,
+    TransferTicket
 )
 from utils.navigator import TezosNavigator
 
@@ -109,6 +109,20 @@ BASIC_OPERATION = OperationGroup([
     )
 ])
 
+def reach_too_long_warning(tezos_navigator: TezosNavigator) -> None:
+    """Go through the clear review up to the warning that the operation
+    is too long.
+
+    The review switches to the summary on the first screen of the
+    operation that is certain to exceed the screen limit: the screens
+    before the warning depend on that prediction and are not compared.
+    """
+    tezos_navigator.navigate_forward(
+        text="^The transaction$",
+        screen_change_before_first_instruction=True,
+        screen_change_after_last_instruction=False
+    )
+
 def test_sign_basic_too_long_operation(
         backend: TezosBackend,
         device: Device,
@@ -125,7 +139,11 @@ def test_sign_basic_too_long_operation(
 
     with backend.sign(account, message, with_hash=True) as result:
         if device.is_nano:
-            tezos_navigator.accept_sign_blindsign_risk(snap_path=snapshot_dir / "clear_n_too_long_warning")
+            reach_too_long_warning(tezos_navigator)
+            tezos_navigator.accept_sign_blindsign_risk(
+                snap_path=snapshot_dir / "clear_n_too_long_warning",
+                screen_change_before_first_instruction=False
+            )
         else:
             tezos_navigator.skip_sign(snap_path=snapshot_dir / "skip")
             tezos_navigator.accept_sign_blindsign_risk(snap_path=snapshot_dir / "blindsign_warning")
@@ -152,7 +170,11 @@ def test_reject_basic_too_long_operation_at_warning(
     with StatusCode.REJECT.expected():
         with backend.sign(account, BASIC_OPERATION):
             if device.is_nano:
-                tezos_navigator.refuse_sign_blindsign_risk(snap_path=snapshot_dir / "clear_n_too_long_warning")
+                reach_too_long_warning(tezos_navigator)
+                tezos_navigator.refuse_sign_blindsign_risk(
+                    snap_path=snapshot_dir / "clear_n_too_long_warning",
+                    screen_change_before_first_instruction=False
+                )
             else:
                 tezos_navigator.skip_sign(snap_path=snapshot_dir / "skip")
                 tezos_navigator.refuse_sign_blindsign_risk(snap_path=snapshot_dir / "blindsign_warning")
@@ -172,7 +194,11 @@ def test_reject_basic_too_long_operation_at_summary(
     with StatusCode.REJECT.expected():
         with backend.sign(account, BASIC_OPERATION):
             if device.is_nano:
-                tezos_navigator.accept_sign_blindsign_risk(snap_path=snapshot_dir / "clear_n_too_long_warning")
+                reach_too_long_warning(tezos_navigator)
+                tezos_navigator.accept_sign_blindsign_risk(
+                    snap_path=snapshot_dir / "clear_n_too_long_warning",
+                    screen_change_before_first_instruction=False
+                )
             else:
                 tezos_navigator.skip_sign(snap_path=snapshot_dir / "skip")
                 tezos_navigator.accept_sign_blindsign_risk(snap_path=snapshot_dir / "blindsign_warning")
@@ -273,7 +299,11 @@ def test_sign_too_long_operation_with_only_transactions(
 
     with backend.sign(account, message, with_hash=True) as result:
         if device.is_nano:
-            tezos_navigator.accept_sign_blindsign_risk(snap_path=snapshot_dir / "clear_n_too_long_warning")
+            reach_too_long_warning(tezos_navigator)
+            tezos_navigator.accept_sign_blindsign_risk(
+                snap_path=snapshot_dir / "clear_n_too_long_warning",
+                screen_change_before_first_instruction=False
+            )
         else:
             tezos_navigator.skip_sign(snap_path=snapshot_dir / "skip")
             tezos_navigator.accept_sign_blindsign_risk(snap_path=snapshot_dir / "blindsign_warning")
@@ -325,7 +355,11 @@ def test_sign_too_long_operation_without_fee_or_amount(
 
     with backend.sign(account, message, with_hash=True) as result:
         if device.is_nano:
-            tezos_navigator.accept_sign_blindsign_risk(snap_path=snapshot_dir / "clear_n_too_long_warning")
+            reach_too_long_warning(tezos_navigator)
+            tezos_navigator.accept_sign_blindsign_risk(
+                snap_path=snapshot_dir / "clear_n_too_long_warning",
+                screen_change_before_first_instruction=False
+            )
         else:
             tezos_navigator.skip_sign(snap_path=snapshot_dir / "skip")
             tezos_navigator.accept_sign_blindsign_risk(snap_path=snapshot_dir / "blindsign_warning")
@@ -337,6 +371,46 @@ def test_sign_too_long_operation_without_fee_or_amount(
         data=result.value
     )
 
+@pytest.mark.use_on_device("nano")
+def test_sign_too_long_operation_at_operation_boundary(
+        backend: TezosBackend,
+        tezos_navigator: TezosNavigator,
+        account: Account
+):
+    """Check the review goes to the summary as soon as the next
+    operation is certain to exceed the screen limit, before any of its
+    screens"""
+
+    # The transaction fits within the limit. The transfer ticket takes
+    # at least 10 screens on Nano S+/X and 13 on Nano S, which always
+    # exceeds it.
+    message = OperationGroup([
+        Transaction(counter=1),
+        TransferTicket(counter=2),
+    ])
+
+    tezos_navigator.toggle_expert_mode()
+    tezos_navigator.toggle_blindsign()
+
+    with backend.sign(account, message, with_hash=True) as result:
+        tezos_navigator.navigate_forward(
+            text=r"^(The transaction|Operation \(1\))$",
+            screen_change_before_first_instruction=True,
+            screen_change_after_last_instruction=False
+        )
+        assert backend.compare_screen_with_text("^The transaction$"), \
+            "The transfer ticket should not be reviewed"
+        tezos_navigator.accept_sign_blindsign_risk(
+            screen_change_before_first_instruction=False
+        )
+        tezos_navigator.accept_sign()
+
+    account.check_signature(
+        message=message,
+        with_hash=True,
+        data=result.value
+    )
+
 
 ### Too long operation containing a too large number ###
 
@@ -492,31 +566,49 @@ def test_blindsign_too_deep(
         snapshot_dir: Path):
     """Check blindsigning on too deep expression"""
 
-    expression = MichelineExpr([[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[{'int':42}]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]])
+    expression = MichelineExpr([[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[{'int':42}]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]])
 
     with backend.sign(account, expression, with_hash=True) as result:
+        # The expression displayed before the error depends on the
+        # depth of the parser stack: go through it without comparing
+        # it, the error is checked from the first warning screen
         if device.type == DeviceType.NANOS:
             ### Simulate `navigate_review` up to `ACCEPT_RISK` because the nanos screen can look like it hasn't changed.
 
-            instructions: List[Union[NavIns, NavInsID]] = [
-                # 'Review operation'
-                NavInsID.RIGHT_CLICK,  # 'Expression {{{...{{{'
-                NavInsID.RIGHT_CLICK,  # 'Expression {{{...{{{'
-                NavInsID.RIGHT_CLICK,  # 'The transaction cannot be trusted.'
-                NavInsID.RIGHT_CLICK,  # 'Parsing error ERR_TOO_DEEP'
-                NavInsID.RIGHT_CLICK,  # 'Learn More: bit.ly/ledger-tez'
-                NavInsID.RIGHT_CLICK,  # 'Accept risk'
-                NavInsID.BOTH_CLICK,
-            ]
-
             tezos_navigator.unsafe_navigate(
-                instructions=instructions,
+                instructions=[
+                    # 'Review operation'
+                    NavInsID.RIGHT_CLICK,  # 'Expression {{{...{{{'
+                    NavInsID.RIGHT_CLICK,  # 'Expression {{{...{{{'
+                    NavInsID.RIGHT_CLICK,  # 'Expression {{{...{{{'
+                    NavInsID.RIGHT_CLICK,  # 'Expression {{{...{{{'
+                    NavInsID.RIGHT_CLICK,  # 'The transaction cannot be trusted.'
+                ],
                 screen_change_before_first_instruction=True,
+            )
+            tezos_navigator.unsafe_navigate(
+                instructions=[
+                    # 'The transaction cannot be trusted.'
+                    NavInsID.RIGHT_CLICK,  # 'Parsing error ERR_TOO_DEEP'
+                    NavInsID.RIGHT_CLICK,  # 'Learn More: bit.ly/ledger-tez'
+                    NavInsID.RIGHT_CLICK,  # 'Accept risk'
+                    NavInsID.BOTH_CLICK,
+                ],
                 screen_change_after_last_instruction=False,
                 snap_path=snapshot_dir / "clear",
             )
         else:
-            tezos_navigator.accept_sign_error_risk(snap_path=snapshot_dir / "clear")
+            if device.is_nano:
+                tezos_navigator.navigate_until_text(
+                    navigate_instruction=NavInsID.RIGHT_CLICK,
+                    text="^The transaction$",
+                    screen_change_before_first_instruction=True,
+                    screen_change_after_last_instruction=False,
+                )
+            tezos_navigator.accept_sign_error_risk(
+                snap_path=snapshot_dir / "clear",
+                screen_change_before_first_instruction=not device.is_nano,
+            )
             if not device.is_nano:
                 tezos_navigator.accept_sign_blindsign_risk(snap_path=snapshot_dir / "blindsigning_warning")
 
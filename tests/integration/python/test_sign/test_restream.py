@@ -0,0 +1,154 @@
+#!/usr/bin/env python3
+# Copyright 2025 Trilitech <contact@trili.tech>
+
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+
+# http://www.apache.org/licenses/LICENSE-2.0
+
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""Gathering of tests related to the rewind of the review on Nano
+devices, the message being sent again."""
+
+from typing import Tuple
+
+import pytest
+
+from ragger.error import ExceptionRAPDU
+from ragger.navigator import NavInsID
+
+from utils.account import Account
+from utils.backend import Ins, StatusCode, TezosBackend, async_thread
+from utils.message import Message, OperationGroup, Transaction
+from utils.navigator import TezosNavigator, TezosNavInsID
+
+
+# Small enough to be sent in a single APDU, with enough screens for the
+# first operation to be dropped from the review history before the
+# last one is displayed
+MESSAGE = OperationGroup([
+    Transaction(counter=1, amount=1_000_000),
+    Transaction(counter=2, amount=2_000_000),
+    Transaction(counter=3, amount=3_000_000),
+])
+
+
+@async_thread
+def sign_restreaming(backend: TezosBackend,
+                     account: Account,
+                     message: Message,
+                     resent: bytes) -> Tuple[bytes, int]:
+    """Requests the signature of a message in a single APDU, sending
+    `resent` instead each time the message is requested again.
+    Returns the signature and the number of requests."""
+    backend._ask_sign(Ins.SIGN, account, restream=True)
+
+    payload = bytes(message)
+    restreams = 0
+    while True:
+        try:
+            return (backend._continue_sign(Ins.SIGN, payload, last=True),
+                    restreams)
+        except ExceptionRAPDU as e:
+            if e.status != StatusCode.RESTREAM:
+                raise
+            restreams += 1
+            payload = resent
+
+
+def review_past_history(tezos_navigator: TezosNavigator) -> None:
+    """Go forward to the third operation, the first one being dropped
+    from the review history."""
+    tezos_navigator.navigate_until_text(
+        navigate_instruction=TezosNavInsID.REVIEW_TX_NEXT,
+        text=r"^Operation \(2\)$",
+        screen_change_before_first_instruction=True,
+        screen_change_after_last_instruction=False
+    )
+
+
+@pytest.mark.use_on_device(["nanos", "nanosp"])
+def test_restream(
+        backend: TezosBackend,
+        tezos_navigator: TezosNavigator,
+        account: Account
+):
+    """Check going back past the review history rewinds the review to
+    the first operation once the message is sent again"""
+
+    with sign_restreaming(backend, account, MESSAGE, bytes(MESSAGE)) as result:
+        review_past_history(tezos_navigator)
+        # Going back past the oldest screen lands on the checkpoint
+        tezos_navigator.navigate_until_text(
+            navigate_instruction=NavInsID.LEFT_CLICK,
+            text=r"^Operation \(0\)$",
+            screen_change_after_last_instruction=False
+        )
+        tezos_navigator.accept_sign(
+            screen_change_before_first_instruction=False
+        )
+
+    (signature, restreams) = result.value
+    assert restreams >= 1, "The message should have been requested again"
+
+    account.check_signature(
+        message=MESSAGE,
+        with_hash=False,
+        data=signature
+    )
+
+
+@pytest.mark.use_on_device(["nanos", "nanosp"])
+def test_restream_changed(
+        backend: TezosBackend,
+        tezos_navigator: TezosNavigator,
+        account: Account
+):
+    """Check the message sent again must start with the part reviewed
+    before the rewind"""
+
+    # Change the branch, which is not displayed
+    changed = bytearray(MESSAGE)
+    changed[1] ^= 0xFF
+
+    with StatusCode.WRONG_VALUES.expected():
+        with sign_restreaming(backend, account, MESSAGE, bytes(changed)):
+            review_past_history(tezos_navigator)
+            tezos_navigator.navigate_until_text(
+                navigate_instruction=NavInsID.LEFT_CLICK,
+                text="^Application$",
+                screen_change_after_last_instruction=False
+            )
+
+
+@pytest.mark.use_on_device(["nanos", "nanosp"])
+def test_no_restream(
+        backend: TezosBackend,
+        tezos_navigator: TezosNavigator,
+        account: Account
+):
+    """Check the review is not rewound for hosts that did not tell they
+    can send the message again"""
+
+    with backend.sign(account, MESSAGE) as result:
+        review_past_history(tezos_navigator)
+        # The oldest screen kept is reached: going back does nothing
+        tezos_navigator.unsafe_navigate(
+            instructions=[NavInsID.LEFT_CLICK] * 30,
+            screen_change_after_last_instruction=False
+        )
+        tezos_navigator.accept_sign(
+            screen_change_before_first_instruction=False
+        )
+
+    account.check_signature(
+        message=MESSAGE,
+        with_hash=False,
+        data=result.value
+    )
@@ -100,6 +100,30 @@ def test_mixing_command(backend: TezosBackend, account: Account):
     with StatusCode.UNEXPECTED_STATE.expected():
         backend.git()
 
+@pytest.mark.parametrize("ins", [Ins.SIGN, Ins.SIGN_WITH_HASH], ids=lambda ins: f"{ins}")
+def test_sign_without_session(backend: TezosBackend, account: Account, ins: Ins):
+    """Check signing in a session requires an open session"""
+
+    message = Transaction()
+
+    with StatusCode.REFERENCED_DATA_NOT_FOUND.expected():
+        backend._exchange(
+            ins,
+            index=Index.SESSION_OTHER_LAST,
+            sig_type=account.sig_type,
+            payload=bytes(message)
+        )
+
+    # Sessions cannot be opened while signing
+    backend._ask_sign(ins, account)
+    with StatusCode.UNEXPECTED_STATE.expected():
+        backend._exchange(
+            ins,
+            index=Index.SESSION_FIRST,
+            sig_type=account.sig_type,
+            payload=account.path
+        )
+
 @pytest.mark.parametrize("ins", [Ins.GET_PUBLIC_KEY, Ins.PROMPT_PUBLIC_KEY], ids=lambda ins: f"{ins}")
 @pytest.mark.parametrize("index", [Index.OTHER, Index.LAST], ids=lambda index: f"{index}")
 def test_wrong_index(backend: TezosBackend, account: Account, ins: Ins, index: Index):
@@ -104,6 +104,7 @@ class Ins(IntEnum):
     QUERY_AUTH_KEY_WITH_CURVE = 0x0d
     HMAC                      = 0x0e
     SIGN_WITH_HASH            = 0x0f
+    PARSE_OPERATION           = 0x11
 
     def __str__(self) -> str:
         return self.name
@@ -111,10 +112,14 @@ class Ins(IntEnum):
 class Index(IntEnum):
     """Class representing packet index."""
 
-    FIRST      = 0x00
-    OTHER      = 0x01
-    LAST       = 0x80
-    OTHER_LAST = 0x81
+    FIRST              = 0x00
+    OTHER              = 0x01
+    RESTREAM           = 0x20
+    SESSION_FIRST      = 0x40
+    SESSION_OTHER      = 0x41
+    LAST               = 0x80
+    OTHER_LAST         = 0x81
+    SESSION_OTHER_LAST = 0xC1
 
     def __str__(self) -> str:
         return self.name
@@ -136,6 +141,7 @@ class StatusCode(IntEnum):
     UNEXPECTED_SIGN_STATE     = 0x9002
     UNKNOWN_CX_ERR            = 0x9003
     UNKNOWN                   = 0x90FF
+    RESTREAM                  = 0x9100
     WRONG_LENGTH_FOR_INS      = 0x917E
     MEMORY_ERROR              = 0x9200
     PARSE_ERROR               = 0x9405
@@ -239,9 +245,19 @@ class TezosBackend(BackendInterface):
         a user confirmation"""
         return self._provide_public_key(account, with_prompt=True)
 
-    def _ask_sign(self, ins: Ins, account: Account) -> None:
-        """Prepare to sign with the account."""
-        data: bytes = self._exchange(ins, sig_type=account.sig_type, payload=account.path)
+    def _ask_sign(self,
+                  ins: Ins,
+                  account: Account,
+                  open_session: bool = False,
+                  restream: bool = False) -> None:
+        """Prepare to sign with the account.
+        Use `open_session` to keep the account for the next signatures
+        Use `restream` to tell the message can be sent again
+        """
+        index: int = Index.SESSION_FIRST if open_session else Index.FIRST
+        if restream:
+            index |= Index.RESTREAM
+        data: bytes = self._exchange(ins, index, sig_type=account.sig_type, payload=account.path)
         assert not data, f"No data expected but got {data.hex()}"
 
     def _continue_sign(self, ins: Ins, payload: bytes, last: bool) -> bytes:
@@ -253,28 +269,113 @@ class TezosBackend(BackendInterface):
             index = Index(index | Index.LAST)
         return self._exchange(ins, index, payload=payload)
 
+    def _send_sign_message(self,
+                           ins: Ins,
+                           msg: bytes,
+                           apdu_size: int,
+                           sent: bytes = b'',
+                           restream: bool = False) -> bytes:
+        """Sends the message to sign, except its part `sent` already sent.
+        Use `restream` to send it again when requested.
+        Returns the response to the last packet.
+        """
+        full_msg = sent + msg
+        while msg:
+            payload = msg[:apdu_size]
+            msg     = msg[apdu_size:]
+            last    = not msg
+            try:
+                data = self._continue_sign(ins, payload, last)
+            except ExceptionRAPDU as e:
+                if not restream or e.status != StatusCode.RESTREAM:
+                    raise
+                # The review went back past the screens kept
+                msg = full_msg
+                continue
+            if last:
+                return data
+            assert not data, f"No data expected but got {data.hex()}"
+
+        assert False, "We should have already returned"
+
     @async_thread
     def sign(self,
              account: Account,
              message: Message,
              with_hash: bool = False,
-             apdu_size: int = MAX_APDU_SIZE) -> bytes:
-        """Requests the signature of a message."""
+             apdu_size: int = MAX_APDU_SIZE,
+             open_session: bool = False,
+             restream: bool = False) -> bytes:
+        """Requests the signature of a message.
+        Use `open_session` to sign the next messages with `sign_in_session`
+        Use `restream` to send the message again when requested
+        """
+        msg = bytes(message)
+        assert msg, "Do not sign empty message"
+
+        ins = Ins.SIGN_WITH_HASH if with_hash else Ins.SIGN
+
+        self._ask_sign(ins, account, open_session, restream)
+
+        return self._send_sign_message(ins, msg, apdu_size, restream=restream)
+
+    @async_thread
+    def sign_in_session(self,
+                        account: Account,
+                        message: Message,
+                        with_hash: bool = False,
+                        apdu_size: int = MAX_APDU_SIZE,
+                        restream: bool = False) -> bytes:
+        """Requests the signature of a message with the account of the
+        signing session, without sending its path.
+        Use `restream` to send the message again when requested
+        """
         msg = bytes(message)
         assert msg, "Do not sign empty message"
 
         ins = Ins.SIGN_WITH_HASH if with_hash else Ins.SIGN
 
-        self._ask_sign(ins, account)
+        payload = msg[:apdu_size]
+        rest    = msg[apdu_size:]
+        index: int = Index.SESSION_OTHER
+        if not rest:
+            index = Index.SESSION_OTHER_LAST
+        if restream:
+            index |= Index.RESTREAM
+        try:
+            data = self._exchange(ins, index, sig_type=account.sig_type, payload=payload)
+        except ExceptionRAPDU as e:
+            if not restream or e.status != StatusCode.RESTREAM:
+                raise
+            # The review went back past the screens kept
+            return self._send_sign_message(ins, msg, apdu_size,
+                                           restream=restream)
+        if not rest:
+            return data
+        assert not data, f"No data expected but got {data.hex()}"
+
+        return self._send_sign_message(ins, rest, apdu_size, sent=payload,
+                                       restream=restream)
+
+    def parse_operation(self,
+                        message: Message,
+                        apdu_size: int = MAX_APDU_SIZE) -> bytes:
+        """Requests the parsing of a message, without signing it.
+        Returns the result of the parsing."""
+        msg = bytes(message)
+        assert msg, "Do not parse empty message"
 
+        index: Index = Index.FIRST
         while msg:
             payload = msg[:apdu_size]
             msg     = msg[apdu_size:]
-            last    = not msg
-            data    = self._continue_sign(ins, payload, last)
-            if last:
+            if not msg:
+                index = Index(index | Index.LAST)
+            data    = self._exchange(Ins.PARSE_OPERATION, index,
+                                     sig_type=0, payload=payload)
+            if data:
                 return data
-            assert not data, f"No data expected but got {data.hex()}"
+            index = Index.OTHER
 
         assert False, "We should have already returned"
 
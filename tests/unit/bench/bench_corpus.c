@@ -0,0 +1,355 @@
+/* Tezos Embedded C parser for Ledger - Benchmark corpora
+
+   Copyright 2025 TriliTech <contact@trili.tech>
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+   http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License. */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "bench_corpus.h"
+#include "formatting.h"
+#include "operation_state.h"
+
+// Micheline node tags, see the Micheline binary encoding
+#define MICHELINE_INT             0
+#define MICHELINE_STRING          1
+#define MICHELINE_SEQ             2
+#define MICHELINE_BYTES           10
+#define MICHELINE_PRIM_0_NOANNOTS 3
+#define MICHELINE_PRIM_0_ANNOTS   4
+#define MICHELINE_PRIM_1_NOANNOTS 5
+#define MICHELINE_PRIM_2_NOANNOTS 7
+
+/**
+ * @brief Append a byte to a corpus
+ *
+ * @param c: corpus
+ * @param b: byte to append
+ */
+static void
+put(bench_corpus_t *c, uint8_t b)
+{
+    if (c->size >= sizeof(c->bytes)) {
+        fprintf(stderr, "corpus %s: too large\n", c->name);
+        exit(1);
+    }
+    c->bytes[c->size++] = b;
+}
+
+/**
+ * @brief Append a buffer to a corpus
+ *
+ * @param c: corpus
+ * @param buf: buffer to append
+ * @param len: length of the buffer
+ */
+static void
+put_bytes(bench_corpus_t *c, const void *buf, size_t len)
+{
+    for (size_t i = 0; i < len; i++) {
+        put(c, ((const uint8_t *)buf)[i]);
+    }
+}
+
+/**
+ * @brief Reserve a 4-bytes big-endian size, to be patched by `close_size`
+ *
+ * @param c: corpus
+ * @return size_t: offset of the size
+ */
+static size_t
+open_size(bench_corpus_t *c)
+{
+    size_t ofs = c->size;
+    put_bytes(c, "\0\0\0\0", 4);
+    return ofs;
+}
+
+/**
+ * @brief Patch a size reserved by `open_size`
+ *
+ * @param c: corpus
+ * @param ofs: offset of the size
+ */
+static void
+close_size(bench_corpus_t *c, size_t ofs)
+{
+    size_t len        = c->size - ofs - 4;
+    c->bytes[ofs]     = (uint8_t)(len >> 24);
+    c->bytes[ofs + 1] = (uint8_t)(len >> 16);
+    c->bytes[ofs + 2] = (uint8_t)(len >> 8);
+    c->bytes[ofs + 3] = (uint8_t)len;
+}
+
+/**
+ * @brief Append a natural number in the Zarith encoding
+ *
+ * @param c: corpus
+ * @param v: number to append
+ */
+static void
+put_nat(bench_corpus_t *c, uint64_t v)
+{
+    while (v >= 0x80) {
+        put(c, (uint8_t)(0x80 | (v & 0x7F)));
+        v >>= 7;
+    }
+    put(c, (uint8_t)v);
+}
+
+/**
+ * @brief Append a positive Micheline int
+ *
+ * @param c: corpus
+ * @param v: number to append
+ */
+static void
+put_micheline_int(bench_corpus_t *c, uint64_t v)
+{
+    put(c, MICHELINE_INT);
+    if (v < 0x40) {
+        put(c, (uint8_t)v);
+        return;
+    }
+    put(c, (uint8_t)(0x80 | (v & 0x3F)));
+    put_nat(c, v >> 6);
+}
+
+/**
+ * @brief Append a Micheline string
+ *
+ * @param c: corpus
+ * @param str: string to append
+ */
+static void
+put_micheline_string(bench_corpus_t *c, const char *str)
+{
+    put(c, MICHELINE_STRING);
+    size_t ofs = open_size(c);
+    put_bytes(c, str, strlen(str));
+    close_size(c, ofs);
+}
+
+/**
+ * @brief Append a pseudo-random 20-bytes hash
+ *
+ * @param c: corpus
+ * @param seed: seed of the hash
+ */
+static void
+put_hash(bench_corpus_t *c, size_t seed)
+{
+    for (size_t i = 0; i < 20; i++) {
+        put(c, (uint8_t)((seed * 131 + i * 29 + 7) & 0xFF));
+    }
+}
+
+/**
+ * @brief Start a corpus: magic byte and branch
+ *
+ * @param c: corpus
+ * @param name: corpus name
+ */
+static void
+start(bench_corpus_t *c, const char *name)
+{
+    c->name = name;
+    c->size = 0;
+    put(c, 0x03);
+    for (size_t i = 0; i < 32; i++) {
+        put(c, (uint8_t)(i * 7));
+    }
+}
+
+/**
+ * @brief Append the common manager operation fields
+ *
+ * @param c: corpus
+ * @param tag: operation tag
+ * @param i: index of the operation in the batch
+ */
+static void
+put_manager(bench_corpus_t *c, tz_operation_tag tag, size_t i)
+{
+    put(c, (uint8_t)tag);
+    put(c, 0x00);  // tz1 source
+    put_hash(c, 1);
+    put_nat(c, 1000 + (i * 37));  // fee
+    put_nat(c, 42000 + i);        // counter
+    put_nat(c, 10600);            // gas limit
+    put_nat(c, 257);              // storage limit
+}
+
+void
+bench_corpus_transactions(bench_corpus_t *corpus, size_t count)
+{
+    start(corpus, "transactions");
+    for (size_t i = 0; i < count; i++) {
+        put_manager(corpus, TZ_OPERATION_TAG_TRANSACTION, i);
+        put_nat(corpus, 123456789 + (i * 1000003));  // amount
+        put(corpus, 0x00);                          // implicit destination
+        put(corpus, (uint8_t)(i % 3));              // tz1, tz2 or tz3
+        put_hash(corpus, i + 2);
+        put(corpus, 0x00);  // no parameters
+    }
+}
+
+void
+bench_corpus_origination(bench_corpus_t *corpus, size_t instrs)
+{
+    char   str[64];
+    size_t code;
+    size_t body;
+
+    start(corpus, "origination");
+    put_manager(corpus, TZ_OPERATION_TAG_ORIGINATION, 0);
+    put_nat(corpus, 0);  // balance
+    put(corpus, 0x00);   // no delegate
+
+    code = open_size(corpus);
+    put(corpus, MICHELINE_SEQ);
+    size_t seq = open_size(corpus);
+    // parameter unit;
+    put(corpus, MICHELINE_PRIM_1_NOANNOTS);
+    put(corpus, TZ_MICHELSON_OP_parameter);
+    put(corpus, MICHELINE_PRIM_0_NOANNOTS);
+    put(corpus, TZ_MICHELSON_OP_unit);
+    // storage (list string);
+    put(corpus, MICHELINE_PRIM_1_NOANNOTS);
+    put(corpus, TZ_MICHELSON_OP_storage);
+    put(corpus, MICHELINE_PRIM_1_NOANNOTS);
+    put(corpus, TZ_MICHELSON_OP_list);
+    put(corpus, MICHELINE_PRIM_0_NOANNOTS);
+    put(corpus, TZ_MICHELSON_OP_string);
+    // code { CDR; PUSH string "..."; CONS; PUSH nat n; DROP; ... }
+    put(corpus, MICHELINE_PRIM_1_NOANNOTS);
+    put(corpus, TZ_MICHELSON_OP_code);
+    put(corpus, MICHELINE_SEQ);
+    body = open_size(corpus);
+    put(corpus, MICHELINE_PRIM_0_NOANNOTS);
+    put(corpus, TZ_MICHELSON_OP_CDR);
+    for (size_t i = 0; i < instrs; i++) {
+        switch (i % 3) {
+        case 0:
+            snprintf(str, sizeof(str), "benchmark \"entry\" number %zu", i);
+            put(corpus, MICHELINE_PRIM_2_NOANNOTS);
+            put(corpus, TZ_MICHELSON_OP_PUSH);
+            put(corpus, MICHELINE_PRIM_0_NOANNOTS);
+            put(corpus, TZ_MICHELSON_OP_string);
+            put_micheline_string(corpus, str);
+            put(corpus, MICHELINE_PRIM_0_NOANNOTS);
+            put(corpus, TZ_MICHELSON_OP_CONS);
+            break;
+        case 1:
+            put(corpus, MICHELINE_PRIM_2_NOANNOTS);
+            put(corpus, TZ_MICHELSON_OP_PUSH);
+            put(corpus, MICHELINE_PRIM_0_NOANNOTS);
+            put(corpus, TZ_MICHELSON_OP_nat);
+            put_micheline_int(corpus, 1000000007ULL * (i + 1));
+            put(corpus, MICHELINE_PRIM_0_NOANNOTS);
+            put(corpus, TZ_MICHELSON_OP_DROP);
+            break;
+        default:
+            put(corpus, MICHELINE_PRIM_0_ANNOTS);
+            put(corpus, TZ_MICHELSON_OP_DUP);
+            size_t annot = open_size(corpus);
+            put_bytes(corpus, "@copy", 5);
+            close_size(corpus, annot);
+            put(corpus, MICHELINE_PRIM_0_NOANNOTS);
+            put(corpus, TZ_MICHELSON_OP_DROP);
+            break;
+        }
+    }
+    put(corpus, MICHELINE_PRIM_0_NOANNOTS);
+    put(corpus, TZ_MICHELSON_OP_NIL);
+    close_size(corpus, body);
+    close_size(corpus, seq);
+    close_size(corpus, code);
+
+    // storage {}
+    put_bytes(corpus, "\0\0\0\5", 4);
+    put(corpus, MICHELINE_SEQ);
+    put_bytes(corpus, "\0\0\0\0", 4);
+}
+
+void
+bench_corpus_soru_messages(bench_corpus_t *corpus, size_t count,
+                           size_t len)
+{
+    start(corpus, "soru_messages");
+    put_manager(corpus, TZ_OPERATION_TAG_SORU_ADD_MSG, 0);
+    size_t messages = open_size(corpus);
+    for (size_t i = 0; i < count; i++) {
+        size_t message = open_size(corpus);
+        for (size_t j = 0; j < len; j++) {
+            put(corpus, (uint8_t)((i + j * 13) & 0xFF));
+        }
+        close_size(corpus, message);
+    }
+    close_size(corpus, messages);
+}
+
+void
+bench_corpus_deep_nesting(bench_corpus_t *corpus, size_t count,
+                          size_t depth)
+{
+    start(corpus, "deep_nesting");
+    for (size_t i = 0; i < count; i++) {
+        put_manager(corpus, TZ_OPERATION_TAG_TRANSACTION, i);
+        put_nat(corpus, 0);  // amount
+        put(corpus, 0x01);   // originated destination
+        put_hash(corpus, i + 2);
+        put(corpus, 0x00);  // padding
+        put(corpus, 0xFF);  // parameters
+        put(corpus, 0x00);  // default entrypoint
+        size_t param = open_size(corpus);
+        // Pair 0 (Pair 1 (... (Pair <depth - 1> Unit)))
+        for (size_t d = 0; d < depth; d++) {
+            put(corpus, MICHELINE_PRIM_2_NOANNOTS);
+            put(corpus, TZ_MICHELSON_OP_Pair);
+            put_micheline_int(corpus, d);
+        }
+        put(corpus, MICHELINE_PRIM_0_NOANNOTS);
+        put(corpus, TZ_MICHELSON_OP_Unit);
+        close_size(corpus, param);
+    }
+}
+
+void
+bench_corpus_bytes_params(bench_corpus_t *corpus, size_t count, size_t len)
+{
+    start(corpus, "bytes_params");
+    for (size_t i = 0; i < count; i++) {
+        put_manager(corpus, TZ_OPERATION_TAG_TRANSACTION, i);
+        put_nat(corpus, 0);  // amount
+        put(corpus, 0x01);   // originated destination
+        put_hash(corpus, i + 2);
+        put(corpus, 0x00);  // padding
+        put(corpus, 0xFF);  // parameters
+        put(corpus, 0x00);  // default entrypoint
+        size_t param = open_size(corpus);
+        // Pair "<metadata key>" 0x<len bytes>
+        put(corpus, MICHELINE_PRIM_2_NOANNOTS);
+        put(corpus, TZ_MICHELSON_OP_Pair);
+        put_micheline_string(corpus, "token\tmetadata\n\"\\\x01\x7f\xc3\xa9");
+        put(corpus, MICHELINE_BYTES);
+        size_t bytes = open_size(corpus);
+        for (size_t j = 0; j < len; j++) {
+            put(corpus, (uint8_t)((i * 7 + j * 31) & 0xFF));
+        }
+        close_size(corpus, bytes);
+        close_size(corpus, param);
+    }
+}
@@ -0,0 +1,88 @@
+/* Tezos Embedded C parser for Ledger - Benchmark corpora
+
+   Copyright 2025 TriliTech <contact@trili.tech>
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+   http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License. */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Maximum size of a generated corpus
+ *
+ *        Large enough for operations beyond 64 KiB, the parser accepts
+ *        up to `TZ_MAX_OFFSET` bytes.
+ */
+#define BENCH_CORPUS_MAX_SIZE 0x40000
+
+/**
+ * @brief A generated binary input for the parser
+ *
+ *        Every corpus starts with the operation magic byte (0x03) and
+ *        is accepted by `tz_operation_parser_init(_, size, false)`.
+ */
+typedef struct {
+    const char *name;                          /// corpus name
+    uint8_t     bytes[BENCH_CORPUS_MAX_SIZE];  /// corpus content
+    size_t      size;                          /// corpus length
+} bench_corpus_t;
+
+/**
+ * @brief Fill a corpus with a batch of plain transactions
+ *
+ * @param corpus: corpus to fill
+ * @param count: number of transactions in the batch
+ */
+void bench_corpus_transactions(bench_corpus_t *corpus, size_t count);
+
+/**
+ * @brief Fill a corpus with an origination carrying a large script
+ *
+ * @param corpus: corpus to fill
+ * @param instrs: number of instructions in the contract code
+ */
+void bench_corpus_origination(bench_corpus_t *corpus, size_t instrs);
+
+/**
+ * @brief Fill a corpus with a smart rollup add messages operation
+ *
+ * @param corpus: corpus to fill
+ * @param count: number of messages
+ * @param len: length of each message
+ */
+void bench_corpus_soru_messages(bench_corpus_t *corpus, size_t count,
+                                size_t len);
+
+/**
+ * @brief Fill a corpus with transactions calling a contract with
+ *        deeply nested parameters
+ *
+ * @param corpus: corpus to fill
+ * @param count: number of transactions in the batch
+ * @param depth: nesting depth of each parameter
+ */
+void bench_corpus_deep_nesting(bench_corpus_t *corpus, size_t count,
+                               size_t depth);
+
+/**
+ * @brief Fill a corpus with transactions calling a contract with a
+ *        string and a large bytes literal, as NFT metadata
+ *
+ * @param corpus: corpus to fill
+ * @param count: number of transactions in the batch
+ * @param len: length of each bytes literal
+ */
+void bench_corpus_bytes_params(bench_corpus_t *corpus, size_t count,
+                               size_t len);
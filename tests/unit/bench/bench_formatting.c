@@ -0,0 +1,282 @@
+/* Tezos Embedded C parser for Ledger - Formatting benchmark
+
+   Copyright 2025 TriliTech <contact@trili.tech>
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+   http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License. */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "formatting.h"
+
+/**
+ * @brief Default number of times each input is formatted
+ */
+#define BENCH_DEFAULT_ITERATIONS 20000
+
+/// Number of random inputs checked against the reference
+#define BENCH_CHECKS 20000
+
+static double
+now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + ((double)ts.tv_nsec / 1e9);
+}
+
+static const char ref_b58digits_ordered[]
+    = "123456789ABCDEFGHJKLMNPQRSTUVWXYZabcdefghijkmnopqrstuvwxyz";
+
+/**
+ * @brief Reference byte per byte base58 conversion (libbase58), as
+ *        formerly used by `tz_format_base58`
+ *
+ *        Only valid for inputs without leading zero bytes.
+ */
+static int
+ref_format_base58(const uint8_t *n, size_t l, char *obuf, size_t olen)
+{
+    int    carry;
+    size_t i, j, high, zcount = 0, obuf_len = TZ_BASE58_BUFFER_SIZE(l);
+
+    if (olen < obuf_len) {
+        return 1;
+    }
+
+    memset(obuf, 0, obuf_len);
+
+    while ((zcount < l) && !n[zcount]) {
+        ++zcount;
+    }
+
+    for (i = zcount, high = obuf_len - 1; i < l; ++i, high = j) {
+        carry = n[i];
+        for (j = obuf_len - 1; ((int)j >= 0) && ((j > high) || carry); --j) {
+            carry += 256 * obuf[j];
+            obuf[j] = (char)(carry % 58);
+            carry /= 58;
+        }
+    }
+
+    for (j = 0; !obuf[j]; ++j) {
+        // Find the last index of obuf
+    }
+    for (i = 0; j < obuf_len; ++i, ++j) {
+        obuf[i] = ref_b58digits_ordered[(unsigned)obuf[j]];
+    }
+    obuf[i] = '\0';
+    return 0;
+}
+
+/**
+ * @brief Reference byte per byte decimal conversion, as formerly used
+ *        by `tz_format_decimal`
+ */
+static int
+ref_format_decimal(const uint8_t *n, size_t l, char *obuf, size_t olen)
+{
+    int    carry;
+    size_t i, j, high, zcount = 0, obuf_len = TZ_DECIMAL_BUFFER_SIZE(l);
+
+    if (olen < obuf_len + 1) {
+        return 1;
+    }
+
+    memset(obuf, 0, obuf_len + 1);
+
+    while ((zcount < l) && !n[l - zcount - 1]) {
+        ++zcount;
+    }
+
+    if (zcount == l) {
+        obuf[0] = '0';
+        return 0;
+    }
+
+    for (i = zcount, high = obuf_len - 1; i < l; ++i, high = j) {
+        carry = n[l - i - 1];
+        for (j = obuf_len - 1; ((int)j >= 0) && ((j > high) || carry); --j) {
+            carry += 256 * obuf[j];
+            obuf[j] = (char)(carry % 10);
+            carry /= 10;
+        }
+    }
+
+    for (j = 0; !obuf[j]; ++j) {
+        // Find the last index of obuf
+    }
+    for (i = 0; j < obuf_len; ++i, ++j) {
+        obuf[i] = (char)('0' + obuf[j]);
+    }
+    obuf[i] = '\0';
+    return 0;
+}
+
+typedef int (*format_fn)(const uint8_t *, size_t, char *, size_t);
+
+static void
+random_bytes(uint8_t *buf, size_t len)
+{
+    for (size_t i = 0; i < len; i++) {
+        buf[i] = (uint8_t)rand();
+    }
+}
+
+/**
+ * @brief Check `tz_format_base58` against the reference
+ *
+ * @return bool: whether every output is identical
+ */
+static bool
+check_base58(void)
+{
+    uint8_t n[TZ_BASE58_MAX_INPUT_SIZE];
+    char    expected[TZ_BASE58_BUFFER_SIZE(TZ_BASE58_MAX_INPUT_SIZE) + 1];
+    char    got[TZ_BASE58_BUFFER_SIZE(TZ_BASE58_MAX_INPUT_SIZE) + 1];
+
+    for (int c = 0; c < BENCH_CHECKS; c++) {
+        size_t l = 1 + ((size_t)rand() % TZ_BASE58_MAX_INPUT_SIZE);
+        random_bytes(n, l);
+        n[0] |= 1;
+        // also exercise small values in large buffers
+        if ((c % 7) == 0) {
+            memset(n, 0xFF, l);
+        } else if ((c % 11) == 0) {
+            n[l - 1] = 1;
+        }
+        if (ref_format_base58(n, l, expected, sizeof(expected))
+            || tz_format_base58(n, l, got, sizeof(got))
+            || strcmp(expected, got)) {
+            fprintf(stderr, "base58 mismatch (length %zu): %s <> %s\n", l,
+                    expected, got);
+            return false;
+        }
+        // leading zero bytes are formatted as '1'
+        size_t z = 1 + ((size_t)c % 4);
+        if (l + z <= TZ_BASE58_MAX_INPUT_SIZE) {
+            memmove(n + z, n, l);
+            memset(n, 0, z);
+            if (tz_format_base58(n, l + z, got, sizeof(got))
+                || (strspn(got, "1") != z) || strcmp(expected, got + z)) {
+                fprintf(stderr, "base58 mismatch (%zu leading zeroes): %s\n",
+                        z, got);
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Check `tz_format_decimal` against the reference
+ *
+ * @return bool: whether every output is identical
+ */
+static bool
+check_decimal(void)
+{
+    uint8_t n[TZ_DECIMAL_MAX_INPUT_SIZE];
+    char    expected[TZ_DECIMAL_BUFFER_SIZE(TZ_DECIMAL_MAX_INPUT_SIZE) + 1];
+    char    got[TZ_DECIMAL_BUFFER_SIZE(TZ_DECIMAL_MAX_INPUT_SIZE) + 1];
+
+    for (int c = 0; c < BENCH_CHECKS; c++) {
+        size_t l = (size_t)rand() % (TZ_DECIMAL_MAX_INPUT_SIZE + 1);
+        random_bytes(n, l);
+        // also exercise limits and small values in large buffers
+        if ((c % 7) == 0) {
+            memset(n, 0xFF, l);
+        } else if ((c % 11) == 0) {
+            memset(n, 0, l);
+        } else if (((c % 13) == 0) && (l > 1)) {
+            memset(n + 1, 0, l - 1);
+        } else if (((c % 17) == 0) && (l > 0)) {
+            n[l - 1] = 0;
+        }
+        if (ref_format_decimal(n, l, expected, sizeof(expected))
+            || tz_format_decimal(n, l, got, sizeof(got))
+            || strcmp(expected, got)) {
+            fprintf(stderr, "decimal mismatch (length %zu): %s <> %s\n", l,
+                    expected, got);
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Time a formatting function on a random input
+ *
+ * @param fn: formatting function
+ * @param n: input
+ * @param l: input length
+ * @param iterations: number of calls
+ * @return double: time per call in nanoseconds
+ */
+static double
+time_format(format_fn fn, const uint8_t *n, size_t l, size_t iterations)
+{
+    char   obuf[512];
+    double start = now();
+    for (size_t i = 0; i < iterations; i++) {
+        fn(n, l, obuf, sizeof(obuf));
+    }
+    return (now() - start) * 1e9 / (double)iterations;
+}
+
+static void
+bench(const char *name, format_fn ref, format_fn fn, size_t l,
+      size_t iterations)
+{
+    uint8_t n[256];
+    random_bytes(n, l);
+    n[0] |= 1;
+    double ref_ns = time_format(ref, n, l, iterations);
+    double ns     = time_format(fn, n, l, iterations);
+    printf("%-8s %6zu %12.1f %12.1f %8.2fx\n", name, l, ref_ns, ns,
+           ref_ns / ns);
+}
+
+int
+main(int argc, char *argv[])
+{
+    size_t iterations = BENCH_DEFAULT_ITERATIONS;
+    if (argc > 1) {
+        iterations = strtoul(argv[1], NULL, 10);
+    }
+    if (iterations == 0) {
+        fprintf(stderr, "usage: %s [iterations]\n", argv[0]);
+        return 1;
+    }
+
+    srand(42);
+    if (!check_base58() || !check_decimal()) {
+        return 1;
+    }
+
+    printf("%-8s %6s %12s %12s %9s\n", "format", "bytes", "ref ns/call",
+           "ns/call", "speedup");
+    // pkh, operation hash, public key and BLS signature with their
+    // base58check prefix and checksum
+    bench("base58", ref_format_base58, tz_format_base58, 27, iterations);
+    bench("base58", ref_format_base58, tz_format_base58, 38, iterations);
+    bench("base58", ref_format_base58, tz_format_base58, 41, iterations);
+    bench("base58", ref_format_base58, tz_format_base58, 104, iterations);
+    // amounts and fees, and the largest numbers of the num parser
+    bench("decimal", ref_format_decimal, tz_format_decimal, 4, iterations);
+    bench("decimal", ref_format_decimal, tz_format_decimal, 8, iterations);
+    bench("decimal", ref_format_decimal, tz_format_decimal, 16, iterations);
+    bench("decimal", ref_format_decimal, tz_format_decimal, 32, iterations);
+    return 0;
+}
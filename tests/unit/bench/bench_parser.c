@@ -0,0 +1,139 @@
+/* Tezos Embedded C parser for Ledger - Parser throughput benchmark
+
+   Copyright 2025 TriliTech <contact@trili.tech>
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+   http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License. */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "bench_corpus.h"
+#include "bench_replay.h"
+
+/**
+ * @brief Size of the output buffer, as on the BAGL devices
+ *        (`TZ_UI_STREAM_CONTENTS_SIZE`)
+ */
+#define BENCH_OUTPUT_SIZE (19 * 4)
+
+/**
+ * @brief Default number of times each corpus is parsed
+ */
+#define BENCH_DEFAULT_ITERATIONS 20
+
+/// Input chunk sizes: byte per byte, small chunks and full APDUs
+static const size_t chunk_sizes[] = {1, 32, 235};
+
+static double
+now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + ((double)ts.tv_nsec / 1e9);
+}
+
+/**
+ * @brief Benchmark a corpus for a chunk size and print the results
+ *
+ * @param state: parser state
+ * @param corpus: corpus to benchmark
+ * @param chunk: input chunk size
+ * @param render: whether the fields are rendered
+ * @param iterations: number of times the corpus is parsed
+ * @return bool: whether every parsing succeeded
+ */
+static bool
+bench_run(tz_parser_state *state, const bench_corpus_t *corpus,
+          size_t chunk, bool render, size_t iterations)
+{
+    bench_stats_t stats = {0};
+    double        start = now();
+    for (size_t i = 0; i < iterations; i++) {
+        if (!bench_replay(state, corpus->name, corpus->bytes, corpus->size,
+                          chunk, BENCH_OUTPUT_SIZE, render, &stats)) {
+            return false;
+        }
+    }
+    double elapsed = now() - start;
+    double bytes   = (double)(corpus->size * iterations);
+    printf("%-14s %6zu %6zu %6s %12.0f %8.2f %10.3f %9.3f %10.1f %10.1f\n",
+           corpus->name, corpus->size, chunk, render ? "yes" : "no",
+           bytes / elapsed, elapsed * 1e9 / bytes,
+           (double)stats.steps / bytes, (double)stats.runs / bytes,
+           (double)stats.refills / (double)iterations,
+           (double)stats.flushes / (double)iterations);
+    return true;
+}
+
+/**
+ * @brief Benchmark a corpus for every chunk size, then without
+ *        rendering, and print the results
+ *
+ * @param state: parser state
+ * @param corpus: corpus to benchmark
+ * @param iterations: number of times the corpus is parsed
+ * @return bool: whether every parsing succeeded
+ */
+static bool
+bench_corpus(tz_parser_state *state, const bench_corpus_t *corpus,
+             size_t iterations)
+{
+    size_t count = sizeof(chunk_sizes) / sizeof(chunk_sizes[0]);
+    for (size_t c = 0; c < count; c++) {
+        if (!bench_run(state, corpus, chunk_sizes[c], true, iterations)) {
+            return false;
+        }
+    }
+    // as in the swap and summary flows, with full APDUs
+    return bench_run(state, corpus, chunk_sizes[count - 1], false,
+                     iterations);
+}
+
+int
+main(int argc, char *argv[])
+{
+    size_t iterations = BENCH_DEFAULT_ITERATIONS;
+    if (argc > 1) {
+        iterations = strtoul(argv[1], NULL, 10);
+    }
+    if (iterations == 0) {
+        fprintf(stderr, "usage: %s [iterations]\n", argv[0]);
+        return 1;
+    }
+
+    tz_parser_state *state  = malloc(sizeof(tz_parser_state));
+    bench_corpus_t  *corpus = malloc(sizeof(bench_corpus_t));
+    bool             ok     = true;
+
+    printf("%-14s %6s %6s %6s %12s %8s %10s %9s %10s %10s\n", "corpus",
+           "size", "chunk", "render", "bytes/s", "ns/byte", "steps/byte",
+           "runs/byte", "refills", "flushes");
+
+    bench_corpus_transactions(corpus, 200);
+    ok &= bench_corpus(state, corpus, iterations);
+    bench_corpus_origination(corpus, 600);
+    ok &= bench_corpus(state, corpus, iterations);
+    bench_corpus_origination(corpus, 8000);
+    ok &= bench_corpus(state, corpus, iterations);
+    bench_corpus_soru_messages(corpus, 16, 2000);
+    ok &= bench_corpus(state, corpus, iterations);
+    bench_corpus_deep_nesting(corpus, 100, 30);
+    ok &= bench_corpus(state, corpus, iterations);
+    bench_corpus_bytes_params(corpus, 30, 1000);
+    ok &= bench_corpus(state, corpus, iterations);
+
+    free(corpus);
+    free(state);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,72 @@
+/* Tezos Embedded C parser for Ledger - Replay of an input through the parser
+
+   Copyright 2025 TriliTech <contact@trili.tech>
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+   http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License. */
+
+#include <stdio.h>
+
+#include "bench_replay.h"
+
+bool
+bench_replay(tz_parser_state *state, const char *name, const uint8_t *bytes,
+             size_t size, size_t chunk, size_t olen, bool render,
+             bench_stats_t *stats)
+{
+    char   obuf[BENCH_REPLAY_MAX_OUTPUT_SIZE + 1];
+    size_t ofs = 0;
+
+    if ((olen == 0) || (olen > BENCH_REPLAY_MAX_OUTPUT_SIZE) || (chunk == 0)
+        || (size >= TZ_UNKNOWN_SIZE)) {
+        fprintf(stderr, "%s: invalid replay parameters\n", name);
+        return false;
+    }
+
+    memset(obuf, 0, sizeof(obuf));
+    tz_operation_parser_init(state, TZ_UNKNOWN_SIZE, false);
+    state->no_render = !render;
+    tz_parser_refill(state, NULL, 0);
+    tz_parser_flush(state, obuf, olen);
+
+    while (true) {
+        tz_operation_parser_run(state, &stats->steps);
+        stats->runs++;
+
+        switch (state->errno) {
+        case TZ_BLO_FEED_ME: {
+            if (ofs >= size) {
+                fprintf(stderr, "%s: unexpected end of input\n", name);
+                return false;
+            }
+            size_t len = MIN(chunk, size - ofs);
+            tz_parser_refill(state, bytes + ofs, len);
+            ofs += len;
+            if (ofs == size) {
+                tz_operation_parser_set_size(state, (uint32_t)size);
+            }
+            stats->refills++;
+            break;
+        }
+        case TZ_BLO_IM_FULL:
+            tz_parser_flush(state, obuf, olen);
+            stats->flushes++;
+            break;
+        case TZ_BLO_DONE:
+            return true;
+        default:
+            fprintf(stderr, "%s: parsing error %s at offset %d\n", name,
+                    tz_parser_result_name(state->errno), state->ofs);
+            return false;
+        }
+    }
+}
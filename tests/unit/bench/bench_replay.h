@@ -0,0 +1,58 @@
+/* Tezos Embedded C parser for Ledger - Replay of an input through the parser
+
+   Copyright 2025 TriliTech <contact@trili.tech>
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+   http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License. */
+
+#pragma once
+
+#include "operation_parser.h"
+
+/// Maximum size of the output buffer of a replay
+#define BENCH_REPLAY_MAX_OUTPUT_SIZE 256
+
+/**
+ * @brief Statistics of a replay
+ */
+typedef struct {
+    size_t steps;    /// number of parser steps
+    size_t runs;     /// number of calls to `tz_operation_parser_run`
+    size_t refills;  /// number of input refills
+    size_t flushes;  /// number of output flushes
+} bench_stats_t;
+
+/**
+ * @brief Parse a whole input, feeding the parser as the application
+ *        does when clear signing
+ *
+ *        The parser is initialized with an unknown size, refilled by
+ *        chunks as APDUs are received, and given the total size with
+ *        the last chunk. The output buffer is entirely flushed each
+ *        time it is full, as if every screen could hold it.
+ *
+ *        Without rendering, the input is only checked, as in the swap
+ *        and summary flows.
+ *
+ * @param state: parser state
+ * @param name: name of the input, for error messages
+ * @param bytes: input
+ * @param size: input length
+ * @param chunk: input chunk size
+ * @param olen: output buffer size, at most `BENCH_REPLAY_MAX_OUTPUT_SIZE`
+ * @param render: whether the fields are rendered
+ * @param stats: statistics to update
+ * @return bool: whether the parsing succeeded
+ */
+bool bench_replay(tz_parser_state *state, const char *name,
+                  const uint8_t *bytes, size_t size, size_t chunk,
+                  size_t olen, bool render, bench_stats_t *stats);
@@ -0,0 +1,248 @@
+/* Tezos Embedded C parser for Ledger - Operation replay tool
+
+   Copyright 2025 TriliTech <contact@trili.tech>
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+   http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License. */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "bench_replay.h"
+
+/// Size of the APDU chunks sent by the clients
+#define REPLAY_DEFAULT_CHUNK_SIZE 235
+
+/**
+ * @brief Output buffer size of a device (`TZ_UI_STREAM_CONTENTS_SIZE`)
+ */
+typedef struct {
+    const char *name;  /// device name
+    size_t      olen;  /// output buffer size
+} replay_device_t;
+
+static const replay_device_t devices[] = {
+    {"nanos",  19 * 1},
+    {"nanosp", 19 * 4},
+    {"nanox",  19 * 4},
+    {"stax",   20 * 1},
+    {"flex",   20 * 1},
+};
+
+/**
+ * @brief Totals of a replay
+ */
+typedef struct {
+    size_t        operations;  /// number of operations replayed
+    size_t        bytes;       /// number of bytes replayed
+    bench_stats_t stats;       /// parser statistics
+    double        time;        /// wall time in seconds
+} replay_totals_t;
+
+static double
+now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + ((double)ts.tv_nsec / 1e9);
+}
+
+/**
+ * @brief Decode an hexadecimal line in place
+ *
+ * @param line: line to decode, trailing spaces are ignored
+ * @param bytes: output, can be `line`
+ * @param size: decoded length
+ * @return bool: whether the line was valid hexadecimal
+ */
+static bool
+decode_hex(const char *line, uint8_t *bytes, size_t *size)
+{
+    size_t len = strlen(line);
+    while ((len > 0) && strchr(" \t\r\n", line[len - 1])) {
+        len--;
+    }
+    if ((len % 2) != 0) {
+        return false;
+    }
+    for (size_t i = 0; i < len; i += 2) {
+        char          digits[3] = {line[i], line[i + 1], '\0'};
+        char         *end;
+        unsigned long b = strtoul(digits, &end, 16);
+        if (*end != '\0') {
+            return false;
+        }
+        bytes[i / 2] = (uint8_t)b;
+    }
+    *size = len / 2;
+    return true;
+}
+
+/**
+ * @brief Replay every operation of a file, one hexadecimal operation
+ *        per line, and print the statistics of each one
+ *
+ * @param state: parser state
+ * @param path: file path, "-" for the standard input
+ * @param chunk: input chunk size
+ * @param olen: output buffer size
+ * @param iterations: number of times each operation is parsed
+ * @param totals: totals to update
+ * @return bool: whether every operation was parsed
+ */
+static bool
+replay_file(tz_parser_state *state, const char *path, size_t chunk,
+            size_t olen, size_t iterations, replay_totals_t *totals)
+{
+    FILE   *f    = strcmp(path, "-") ? fopen(path, "r") : stdin;
+    char   *line = NULL;
+    size_t  cap  = 0;
+    size_t  lineno;
+    ssize_t len;
+    bool    ok = true;
+
+    if (f == NULL) {
+        perror(path);
+        return false;
+    }
+
+    for (lineno = 1; (len = getline(&line, &cap, f)) >= 0; lineno++) {
+        char          name[256];
+        size_t        size;
+        bench_stats_t stats = {0};
+
+        snprintf(name, sizeof(name), "%s:%zu", path, lineno);
+        if (!decode_hex(line, (uint8_t *)line, &size)) {
+            fprintf(stderr, "%s: invalid hexadecimal\n", name);
+            ok = false;
+            continue;
+        }
+        if (size == 0) {
+            continue;
+        }
+
+        double start = now();
+        for (size_t i = 0; i < iterations; i++) {
+            if (!bench_replay(state, name, (uint8_t *)line, size, chunk, olen,
+                              true, &stats)) {
+                ok = false;
+                break;
+            }
+        }
+        double elapsed = (now() - start) / (double)iterations;
+
+        printf("%-24s %6zu %8zu %8zu %8zu %10.1f\n", name, size,
+               stats.steps / iterations, stats.refills / iterations,
+               stats.flushes / iterations, elapsed * 1e6);
+        totals->operations++;
+        totals->bytes += size;
+        totals->stats.steps += stats.steps / iterations;
+        totals->stats.refills += stats.refills / iterations;
+        totals->stats.flushes += stats.flushes / iterations;
+        totals->time += elapsed;
+    }
+
+    free(line);
+    if (f != stdin) {
+        fclose(f);
+    }
+    return ok;
+}
+
+static void
+usage(const char *prog)
+{
+    fprintf(stderr,
+            "usage: %s [-c chunk] [-o output_size | -d device] "
+            "[-n iterations] [file...]\n"
+            "  Replays operations given in hexadecimal, one per line, as\n"
+            "  the application parses them when clear signing.\n"
+            "  -c: input chunk size (default %d)\n"
+            "  -o: output buffer size (default: nanosp)\n"
+            "  -d: output buffer size of a device:",
+            prog, REPLAY_DEFAULT_CHUNK_SIZE);
+    for (size_t i = 0; i < sizeof(devices) / sizeof(devices[0]); i++) {
+        fprintf(stderr, " %s (%zu)", devices[i].name, devices[i].olen);
+    }
+    fprintf(stderr,
+            "\n"
+            "  -n: number of times each operation is parsed (default 1)\n"
+            "  Reads the standard input when no file is given.\n");
+}
+
+int
+main(int argc, char *argv[])
+{
+    size_t          chunk      = REPLAY_DEFAULT_CHUNK_SIZE;
+    size_t          olen       = devices[1].olen;
+    size_t          iterations = 1;
+    replay_totals_t totals     = {0};
+    bool            ok         = true;
+    int             opt;
+
+    while ((opt = getopt(argc, argv, "c:o:d:n:h")) != -1) {
+        switch (opt) {
+        case 'c':
+            chunk = strtoul(optarg, NULL, 10);
+            break;
+        case 'o':
+            olen = strtoul(optarg, NULL, 10);
+            break;
+        case 'd':
+            olen = 0;
+            for (size_t i = 0; i < sizeof(devices) / sizeof(devices[0]);
+                 i++) {
+                if (!strcmp(optarg, devices[i].name)) {
+                    olen = devices[i].olen;
+                }
+            }
+            break;
+        case 'n':
+            iterations = strtoul(optarg, NULL, 10);
+            break;
+        default:
+            usage(argv[0]);
+            return 1;
+        }
+    }
+    if ((chunk == 0) || (olen == 0) || (olen > BENCH_REPLAY_MAX_OUTPUT_SIZE)
+        || (iterations == 0)) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    tz_parser_state *state = malloc(sizeof(tz_parser_state));
+
+    printf("%-24s %6s %8s %8s %8s %10s\n", "operation", "size", "steps",
+           "refills", "flushes", "us");
+    if (optind == argc) {
+        ok &= replay_file(state, "-", chunk, olen, iterations, &totals);
+    }
+    for (int i = optind; i < argc; i++) {
+        ok &= replay_file(state, argv[i], chunk, olen, iterations, &totals);
+    }
+    printf("%-24s %6zu %8zu %8zu %8zu %10.1f\n", "total", totals.bytes,
+           totals.stats.steps, totals.stats.refills, totals.stats.flushes,
+           totals.time * 1e6);
+    if (totals.bytes > 0) {
+        printf("%zu operations, chunk %zu, output %zu: %.3f steps/byte, "
+               "%.0f bytes/s\n",
+               totals.operations, chunk, olen,
+               (double)totals.stats.steps / (double)totals.bytes,
+               (double)totals.bytes / totals.time);
+    }
+
+    free(state);
+    return ok ? 0 : 1;
+}
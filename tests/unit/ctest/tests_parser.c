@@ -14,7 +14,10 @@
 
 #include <stdlib.h>
 #include "ctest.h"
+#include "micheline_parser.h"
+#include "num_parser.h"
 #include "operation_parser.h"
+#include "ui_glyphs.h"
 
 CTEST_DATA(operation_parser)
 {
@@ -583,3 +586,644 @@ CTEST2(operation_parser, check_sc_rollup_originate_complexity)
     };
     check_field_complexity(data, str, fields_check, sizeof(fields_check));
 }
+
+/**
+ * @brief Parse a whole operation, flushing the output when full
+ *
+ * @param data: test data
+ * @param str: operation, in hexadecimal
+ * @return size_t: number of output flushes
+ */
+static size_t
+parse_all(struct ctest_operation_parser_data *data, char *str)
+{
+    fill_data_str(data, str);
+    tz_operation_parser_set_size(data->state, (uint32_t)data->str_len);
+
+    tz_parser_state *st      = data->state;
+    size_t           flushes = 0;
+
+    while (true) {
+        while (!TZ_IS_BLOCKED(tz_operation_parser_step(st))) {
+            // Loop while the result is successful and not blocking
+        }
+
+        switch (st->errno) {
+        case TZ_BLO_FEED_ME:
+            refill(data);
+            tz_parser_refill(data->state, data->ibuf, data->ilen);
+            continue;
+        case TZ_BLO_IM_FULL:
+            tz_parser_flush(st, data->obuf, data->olen);
+            flushes++;
+            continue;
+        case TZ_BLO_DONE:
+            return flushes;
+        default:
+            CTEST_ERR("%s:%d parsing error: %s", __FILE__, __LINE__,
+                      tz_parser_result_name(st->errno));
+        }
+    }
+}
+
+CTEST2(operation_parser, check_no_render)
+{
+    char str[]
+        = "030000000000000000000000000000000000000000000000000000000000000000"
+          "6c00ffdd6102321bc251e4a5190ad5b12b251069d9b4a0c21e020304904e010000"
+          "0000000000000000000000000000000000000000"
+          "6c016e8874874d31c3fbd636e924d5a036a43ec8faa7d0860308362d80d30e0100"
+          "0000000000000000000000000000000000000000ff02000000020316";
+    tz_operation_state rendered;
+
+    ASSERT_TRUE(parse_all(data, str) > 0);
+    memcpy(&rendered, &data->state->operation, sizeof(rendered));
+
+    tz_operation_parser_init(data->state, TZ_UNKNOWN_SIZE, false);
+    data->state->no_render = true;
+    tz_parser_refill(data->state, NULL, 0);
+    tz_parser_flush(data->state, data->obuf, data->olen);
+    ASSERT_EQUAL_U(0, parse_all(data, str));
+    ASSERT_EQUAL_U(0, data->state->regs.oofs);
+
+    const tz_operation_state *op = &data->state->operation;
+    ASSERT_EQUAL_U(rendered.total_fee, op->total_fee);
+    ASSERT_EQUAL_U(rendered.total_amount, op->total_amount);
+    ASSERT_EQUAL_U(rendered.batch_index, op->batch_index);
+    ASSERT_DATA(rendered.source, 21, op->source, 21);  // tag and hash
+    ASSERT_DATA(rendered.destination, 22, op->destination, 22);
+}
+
+CTEST2(operation_parser, check_min_screens)
+{
+    char str[]
+        = "030000000000000000000000000000000000000000000000000000000000000000"
+          "6c016e8874874d31c3fbd636e924d5a036a43ec8faa7d0860308362d80d30e0100"
+          "0000000000000000000000000000000000000000ff02000000020316";
+    tz_parser_state *st      = data->state;
+    size_t           flushes = 0;
+
+    ASSERT_EQUAL_U(0, tz_operation_parser_min_screens(st, data->olen));
+
+    fill_data_str(data, str);
+    tz_operation_parser_set_size(st, (uint32_t)data->str_len);
+    while (st->errno != TZ_BLO_DONE) {
+        tz_operation_parser_run(st, NULL);
+        ASSERT_FALSE(TZ_IS_ERR(st->errno));
+        if (st->errno == TZ_BLO_FEED_ME) {
+            refill(data);
+            tz_parser_refill(st, data->ibuf, data->ilen);
+        } else if (st->errno == TZ_BLO_IM_FULL) {
+            if (flushes == 0) {
+                // name, source, fee, storage limit, amount, destination
+                ASSERT_EQUAL_U(6, tz_operation_parser_min_screens(st, 76));
+                // the addresses take two screens of 19 characters
+                ASSERT_EQUAL_U(8, tz_operation_parser_min_screens(st, 19));
+            }
+            tz_parser_flush(st, data->obuf, data->olen);
+            flushes++;
+        }
+    }
+
+    // the parameters, optional, are displayed too
+    ASSERT_EQUAL_U(8, flushes);
+}
+
+static tz_operation_field_kind hook_calls[8];
+static size_t                  hook_count;
+
+static bool
+reject_amount_hook(tz_operation_field_kind kind)
+{
+    if (hook_count < (sizeof(hook_calls) / sizeof(hook_calls[0]))) {
+        hook_calls[hook_count] = kind;
+    }
+    hook_count++;
+    return kind != TZ_OPERATION_FIELD_AMOUNT;
+}
+
+CTEST2(operation_parser, check_hook_rejects_early)
+{
+    char str[]
+        = "030000000000000000000000000000000000000000000000000000000000000000"
+          "6c00ffdd6102321bc251e4a5190ad5b12b251069d9b4a0c21e020304904e010000"
+          "0000000000000000000000000000000000000000"
+          "6c016e8874874d31c3fbd636e924d5a036a43ec8faa7d0860308362d80d30e0100"
+          "0000000000000000000000000000000000000000ff02000000020316";
+    tz_parser_state *st = data->state;
+
+    hook_count         = 0;
+    st->operation.hook        = reject_amount_hook;
+    fill_data_str(data, str);
+    tz_operation_parser_set_size(st, (uint32_t)data->str_len);
+
+    while (!TZ_IS_ERR(st->errno) && (st->errno != TZ_BLO_DONE)) {
+        tz_operation_parser_step(st);
+        if (st->errno == TZ_BLO_FEED_ME) {
+            refill(data);
+            tz_parser_refill(st, data->ibuf, data->ilen);
+        } else if (st->errno == TZ_BLO_IM_FULL) {
+            tz_parser_flush(st, data->obuf, data->olen);
+        }
+    }
+
+    ASSERT_EQUAL(TZ_ERR_REJECTED, st->errno);
+    ASSERT_EQUAL_U(2, hook_count);
+    ASSERT_EQUAL(TZ_OPERATION_FIELD_FEE, hook_calls[0]);
+    ASSERT_EQUAL(TZ_OPERATION_FIELD_AMOUNT, hook_calls[1]);
+    ASSERT_EQUAL_U(10000, st->operation.total_amount);
+    // the second transaction is never read
+    ASSERT_TRUE((size_t)st->ofs < data->str_len);
+}
+
+#ifdef TZ_OPERATION_CHECKPOINT
+
+#define FIELDS_LOG_LEN  24
+#define FIELDS_LOG_SIZE 96
+
+/**
+ * @brief Parse what is left of the input, logging each field printed
+ *        with its content
+ *
+ * @param data: test data, with the input to parse
+ * @param log: fields printed
+ * @param checkpoint: if not NULL, set to the checkpoint of the second
+ *                    operation of the batch
+ * @return size_t: number of fields printed
+ */
+static size_t
+parse_logged(struct ctest_operation_parser_data *data,
+             char                     log[FIELDS_LOG_LEN][FIELDS_LOG_SIZE],
+             tz_operation_checkpoint *checkpoint)
+{
+    tz_parser_state *st    = data->state;
+    size_t           count = 0;
+
+    while (st->errno != TZ_BLO_DONE) {
+        tz_operation_parser_run(st, NULL);
+        ASSERT_FALSE(TZ_IS_ERR(st->errno));
+        if (st->errno == TZ_BLO_FEED_ME) {
+            refill(data);
+            tz_parser_refill(st, data->ibuf, data->ilen);
+        } else if (st->errno == TZ_BLO_IM_FULL) {
+            if ((checkpoint != NULL)
+                && (strcmp(st->field_info.field_name, "Operation (1)")
+                    == 0)) {
+                *checkpoint = st->operation.checkpoint;
+            }
+            ASSERT_TRUE(count < FIELDS_LOG_LEN);
+            snprintf(log[count], FIELDS_LOG_SIZE, "%s: %s",
+                     st->field_info.field_name, data->obuf);
+            tz_parser_flush(st, data->obuf, data->olen);
+            count++;
+        }
+    }
+    return count;
+}
+
+CTEST2(operation_parser, check_restore)
+{
+    char str[]
+        = "030000000000000000000000000000000000000000000000000000000000000000"
+          "6c00ffdd6102321bc251e4a5190ad5b12b251069d9b4a0c21e020304904e010000"
+          "0000000000000000000000000000000000000000"
+          "6c016e8874874d31c3fbd636e924d5a036a43ec8faa7d0860308362d80d30e0100"
+          "0000000000000000000000000000000000000000ff02000000020316";
+    char                    fields[FIELDS_LOG_LEN][FIELDS_LOG_SIZE];
+    char                    restored[FIELDS_LOG_LEN][FIELDS_LOG_SIZE];
+    tz_operation_checkpoint checkpoint;
+    tz_operation_state      parsed;
+
+    memset(&checkpoint, 0, sizeof(checkpoint));
+    fill_data_str(data, str);
+    tz_operation_parser_set_size(data->state, (uint32_t)data->str_len);
+    size_t count = parse_logged(data, fields, &checkpoint);
+    memcpy(&parsed, &data->state->operation, sizeof(parsed));
+
+    // magic byte, branch and the first transaction
+    ASSERT_EQUAL_U(86, checkpoint.ofs);
+    ASSERT_EQUAL_U(1, checkpoint.batch_index);
+    ASSERT_EQUAL_U(6, checkpoint.field_index);
+
+    tz_operation_parser_restore(data->state, (uint32_t)data->str_len,
+                                &checkpoint);
+    tz_parser_refill(data->state, NULL, 0);
+    tz_parser_flush(data->state, data->obuf, data->olen);
+    data->str_ofs = 2 * checkpoint.ofs;
+    size_t restored_count = parse_logged(data, restored, NULL);
+
+    // the fields of the second transaction are printed again
+    ASSERT_TRUE(restored_count < count);
+    for (size_t i = 0; i < restored_count; i++) {
+        ASSERT_STR(fields[count - restored_count + i], restored[i]);
+    }
+    ASSERT_STR("Operation (1): Transaction", restored[0]);
+
+    const tz_operation_state *op = &data->state->operation;
+    ASSERT_EQUAL_U(parsed.total_fee, op->total_fee);
+    ASSERT_EQUAL_U(parsed.total_amount, op->total_amount);
+    ASSERT_EQUAL_U(parsed.batch_index, op->batch_index);
+    ASSERT_DATA(parsed.source, 22, op->source, 22);
+    ASSERT_EQUAL(parsed.checkpoint.ofs, op->checkpoint.ofs);
+}
+
+#endif  // TZ_OPERATION_CHECKPOINT
+
+#ifdef TZ_PARSER_COUNTERS
+
+static void
+dump_counter(const char *kind, const char *name,
+             const tz_parser_counter *counter)
+{
+    if (counter->steps != 0) {
+        CTEST_LOG("%-9s %-21s steps: %5u bytes: %5u chars: %5u", kind, name,
+                  counter->steps, counter->bytes, counter->chars);
+    }
+}
+
+static void
+dump_counters(const tz_parser_counters *counters)
+{
+    for (int i = 0; i < TZ_OPERATION_STEP_COUNT; i++) {
+        dump_counter("operation", tz_operation_parser_step_name[i],
+                     &counters->operation_steps[i]);
+    }
+    for (int i = 0; i < TZ_MICHELINE_STEP_COUNT; i++) {
+        dump_counter("micheline", tz_micheline_parser_step_name[i],
+                     &counters->micheline_steps[i]);
+    }
+    dump_counter("tag", "(none)", &counters->operation_tags[0]);
+    for (int i = 0; i < TZ_OPERATION_TAG_COUNT; i++) {
+        dump_counter("tag", tz_operation_descriptors[i].name,
+                     &counters->operation_tags[i + 1]);
+    }
+}
+
+CTEST2(operation_parser, check_counters)
+{
+    char str[]
+        = "030000000000000000000000000000000000000000000000000000000000000000"
+          "6c00ffdd6102321bc251e4a5190ad5b12b251069d9b4a0c21e020304904e010000"
+          "0000000000000000000000000000000000000000"
+          "6c016e8874874d31c3fbd636e924d5a036a43ec8faa7d0860308362d80d30e0100"
+          "0000000000000000000000000000000000000000ff02000000020316";
+    parse_all(data, str);
+
+    const tz_parser_counters *counters = &data->state->counters;
+    uint32_t                  op_bytes = 0, tag_bytes = 0, mich_bytes = 0;
+    uint32_t                  op_chars = 0, mich_chars = 0;
+    for (int i = 0; i < TZ_OPERATION_STEP_COUNT; i++) {
+        op_bytes += counters->operation_steps[i].bytes;
+        op_chars += counters->operation_steps[i].chars;
+    }
+    for (int i = 0; i < TZ_MICHELINE_STEP_COUNT; i++) {
+        mich_bytes += counters->micheline_steps[i].bytes;
+        mich_chars += counters->micheline_steps[i].chars;
+    }
+    for (int i = 0; i <= TZ_OPERATION_TAG_COUNT; i++) {
+        tag_bytes += counters->operation_tags[i].bytes;
+    }
+    dump_counters(counters);
+
+    const tz_parser_counter *read_micheline
+        = &counters->operation_steps[TZ_OPERATION_STEP_READ_MICHELINE];
+    ASSERT_EQUAL_U(data->str_len, op_bytes);
+    ASSERT_EQUAL_U(data->str_len, tag_bytes);
+    // magic byte and branch
+    ASSERT_EQUAL_U(33, counters->operation_tags[0].bytes);
+    ASSERT_EQUAL_U(read_micheline->bytes, mich_bytes);
+    ASSERT_EQUAL_U(read_micheline->chars, mich_chars);
+    ASSERT_TRUE(op_chars > 0);
+}
+#endif
+
+/**
+ * @brief Parse a Zarith natural number given in hexadecimal
+ *
+ * @param buffers: number parser buffers
+ * @param regs: number parser register
+ * @param hex: encoded number
+ */
+static void
+parse_nat(tz_num_parser_buffer *buffers, tz_num_parser_regs *regs,
+          const char *hex)
+{
+    uint8_t b;
+    memset(buffers, 0, sizeof(tz_num_parser_buffer));
+    tz_parse_num_state_init(buffers, regs);
+    while (!regs->stop && (sscanf(hex, "%2hhx", &b) == 1)) {
+        ASSERT_EQUAL(TZ_CONTINUE, tz_parse_nat_step(buffers, regs, b));
+        hex += 2;
+    }
+    ASSERT_TRUE(regs->stop);
+}
+
+CTEST(num_parser, check_u64_accumulator)
+{
+    tz_num_parser_buffer buffers;
+    tz_num_parser_regs   regs;
+
+    parse_nat(&buffers, &regs, "00");
+    ASSERT_FALSE(regs.overflow);
+    ASSERT_EQUAL_U(0, buffers.value);
+    ASSERT_STR("0", buffers.decimal);
+
+    parse_nat(&buffers, &regs, "e0c41e");
+    ASSERT_FALSE(regs.overflow);
+    ASSERT_EQUAL_U(500320, buffers.value);
+    ASSERT_STR("500320", buffers.decimal);
+
+    // 2^64 - 1
+    parse_nat(&buffers, &regs, "ffffffffffffffffff01");
+    ASSERT_FALSE(regs.overflow);
+    ASSERT_TRUE(buffers.value == UINT64_MAX);
+    ASSERT_STR("18446744073709551615", buffers.decimal);
+
+    // 2^64
+    parse_nat(&buffers, &regs, "80808080808080808002");
+    ASSERT_TRUE(regs.overflow);
+    ASSERT_STR("18446744073709551616", buffers.decimal);
+
+    // 2^70, with a trailing zero group
+    parse_nat(&buffers, &regs, "808080808080808080808100");
+    ASSERT_TRUE(regs.overflow);
+    ASSERT_STR("1180591620717411303424", buffers.decimal);
+}
+
+/**
+ * @brief Parse a micheline expression, flushing the output often
+ *
+ * @param ibuf: binary expression
+ * @param len: length of the expression
+ * @param out: output, the printed expression
+ * @param olen: size of the output
+ * @return tz_parser_result: final parser result
+ */
+static tz_parser_result
+parse_micheline(const uint8_t *ibuf, size_t len, char *out, size_t olen)
+{
+    static tz_parser_state state;
+    char                   obuf[8];
+
+    memset(out, 0, olen);
+    memset(obuf, 0, sizeof(obuf));
+    tz_parser_init(&state);
+    tz_micheline_parser_init(&state);
+    tz_parser_refill(&state, ibuf, len);
+    tz_parser_flush(&state, obuf, sizeof(obuf) - 1);
+    while (true) {
+        while (!TZ_IS_BLOCKED(tz_micheline_parser_step(&state))) {
+            // Loop while the result is successful and not blocking
+        }
+        strncat(out, obuf, olen - strlen(out) - 1);
+        if (state.errno != TZ_BLO_IM_FULL) {
+            return state.errno;
+        }
+        tz_parser_flush(&state, obuf, sizeof(obuf) - 1);
+    }
+}
+
+/**
+ * @brief Parse nested micheline sequences around an int
+ *
+ * @param depth: number of nested sequences
+ * @return tz_parser_result: final parser result
+ */
+static tz_parser_result
+parse_nested_seqs(size_t depth)
+{
+    uint8_t ibuf[1024];
+    char    out[256];
+    size_t  len = 2 + (5 * depth);
+
+    // { { ... { 42 } ... } }
+    ibuf[len - 2] = 0x00;
+    ibuf[len - 1] = 0x2a;
+    for (size_t d = 0; d < depth; d++) {
+        size_t   ofs  = 5 * (depth - d - 1);
+        uint32_t size = (uint32_t)(len - ofs - 5);
+        ibuf[ofs]     = 0x02;
+        ibuf[ofs + 1] = (uint8_t)(size >> 24);
+        ibuf[ofs + 2] = (uint8_t)(size >> 16);
+        ibuf[ofs + 3] = (uint8_t)(size >> 8);
+        ibuf[ofs + 4] = (uint8_t)size;
+    }
+    return parse_micheline(ibuf, len, out, sizeof(out));
+}
+
+CTEST(micheline_parser, check_nesting_depth)
+{
+    ASSERT_EQUAL(TZ_BLO_DONE, parse_nested_seqs(1));
+    ASSERT_EQUAL(TZ_BLO_DONE, parse_nested_seqs(80));
+    ASSERT_EQUAL(TZ_ERR_TOO_DEEP, parse_nested_seqs(100));
+}
+
+/**
+ * @brief Write a 4-bytes size
+ *
+ * @param buf: output
+ * @param size: size
+ */
+static void
+put_size(uint8_t *buf, uint32_t size)
+{
+    buf[0] = (uint8_t)(size >> 24);
+    buf[1] = (uint8_t)(size >> 16);
+    buf[2] = (uint8_t)(size >> 8);
+    buf[3] = (uint8_t)size;
+}
+
+CTEST(micheline_parser, check_large_sizes)
+{
+    // { "aa...a" ; Pair 1 2 3 ; Unit %a }, beyond 64 KiB
+    static const uint8_t tail[]
+        = {0x09, 0x07, 0x00, 0x00, 0x00, 0x06, 0x00, 0x01, 0x00,
+           0x02, 0x00, 0x03, 0x00, 0x00, 0x00, 0x00, 0x04, 0x0b,
+           0x00, 0x00, 0x00, 0x02, 0x25, 0x61};
+    size_t   str_len = 70000;
+    size_t   len     = 5 + 5 + str_len + sizeof(tail);
+    uint8_t *ibuf    = malloc(len);
+    char     out[64];
+
+    ibuf[0] = 0x02;
+    put_size(ibuf + 1, (uint32_t)(len - 5));
+    ibuf[5] = 0x01;
+    put_size(ibuf + 6, (uint32_t)str_len);
+    memset(ibuf + 10, 'a', str_len);
+    memcpy(ibuf + 10 + str_len, tail, sizeof(tail));
+    ASSERT_EQUAL(TZ_BLO_DONE, parse_micheline(ibuf, len, out, sizeof(out)));
+
+    // a string of 16 MiB
+    put_size(ibuf + 6, 0x01000000);
+    ASSERT_EQUAL(TZ_ERR_TOO_LARGE,
+                 parse_micheline(ibuf, len, out, sizeof(out)));
+    free(ibuf);
+}
+
+/**
+ * @brief Check the printing of a micheline expression
+ *
+ * @param hex: binary expression, in hexadecimal
+ * @param expected: expected printed expression
+ */
+static void
+check_micheline(const char *hex, const char *expected)
+{
+    uint8_t ibuf[256];
+    char    out[256];
+    size_t  len = 0;
+
+    while (sscanf(hex + (2 * len), "%2hhx", &ibuf[len]) == 1) {
+        len++;
+    }
+    ASSERT_EQUAL(TZ_BLO_DONE, parse_micheline(ibuf, len, out, sizeof(out)));
+    ASSERT_STR(expected, out);
+}
+
+CTEST(micheline_parser, check_right_combs)
+{
+    // Pair 0 (Pair 1 2)
+    check_micheline("07070000070700010002", "Pair 0 1 2");
+    // Pair (Pair 0 1) 2
+    check_micheline("07070707000000010002", "Pair (Pair 0 1) 2");
+    // Left (Pair 0 (Pair 1 (Pair 2 Unit)))
+    check_micheline("0505070700000707000107070002030b",
+                    "Left (Pair 0 1 2 Unit)");
+    // Pair (Pair 0 (Pair 1 2)) 3
+    check_micheline("0707070700000707000100020003", "Pair (Pair 0 1 2) 3");
+    // Pair 0 (Pair 1 2 %a), annotated
+    check_micheline("07070000080700010002000000022561",
+                    "Pair 0 (Pair 1 2 %a)");
+    // Pair 0 (Pair 1 2 3), with three arguments
+    check_micheline("0707000009070000000600010002000300000000",
+                    "Pair 0 (Pair 1 2 3)");
+    // Pair 0 (Right (Pair 1 2))
+    check_micheline("070700000508070700010002", "Pair 0 (Right (Pair 1 2))");
+    // Pair 0 (Pair 1 2), the last pair with a sized list of arguments
+    check_micheline("070700000907000000040001000200000000",
+                    "Pair 0 (Pair 1 2)");
+    // Pair 0 (Pair 1 2), the first pair with a sized list of arguments
+    check_micheline("090700000008000007070001000200000000",
+                    "Pair 0 (Pair 1 2)");
+}
+
+CTEST(parser_state, check_put_span)
+{
+    tz_parser_state state;
+    char            obuf[8];
+    size_t          written;
+
+    tz_parser_init(&state);
+    memset(obuf, 0, sizeof(obuf));
+    tz_parser_flush(&state, obuf, 5);
+
+    ASSERT_EQUAL(TZ_CONTINUE, tz_parser_put_span(&state, "abc", &written));
+    ASSERT_EQUAL_U(3, written);
+    ASSERT_EQUAL(TZ_BLO_IM_FULL,
+                 tz_parser_put_span(&state, "defgh", &written));
+    ASSERT_EQUAL_U(2, written);
+    ASSERT_STR("abcde", obuf);
+
+    // resume after the flush
+    tz_parser_flush(&state, obuf, 5);
+    ASSERT_EQUAL(TZ_CONTINUE,
+                 tz_parser_put_span(&state, "defgh" + 2, &written));
+    ASSERT_EQUAL_U(3, written);
+    ASSERT_EQUAL(TZ_CONTINUE, tz_parser_put_span(&state, "", &written));
+    ASSERT_EQUAL_U(0, written);
+    ASSERT_STR("fgh", obuf);
+}
+
+CTEST(formatting, check_address_prefixes)
+{
+    uint8_t address[22];
+    char    obuf[TZ_BASE58CHECK_BUFFER_SIZE(20, 3) + 1];
+
+    for (int i = 0; i < 20; i++) {
+        address[1 + i] = (uint8_t)(i + 1);
+    }
+    address[21] = 0;
+
+    address[0] = 1;
+    ASSERT_EQUAL(0, tz_format_address(address, 22, obuf, sizeof(obuf)));
+    ASSERT_STR("KT18g6ejmStajqDwZZ5ZwTfu1ZKzhYq5RboW", obuf);
+
+    address[0] = 3;
+    ASSERT_EQUAL(0, tz_format_address(address, 22, obuf, sizeof(obuf)));
+    ASSERT_STR("sr168fzzSa1h32J7tTvLxwSzcD17kX624zF3", obuf);
+    ASSERT_EQUAL(0, tz_format_base58check("sr1", address + 1, 20, obuf,
+                                          sizeof(obuf)));
+    ASSERT_STR("sr168fzzSa1h32J7tTvLxwSzcD17kX624zF3", obuf);
+
+    address[0] = 5;
+    ASSERT_NOT_EQUAL(0, tz_format_address(address, 22, obuf, sizeof(obuf)));
+
+    // implicit account: tag(1) + pkh tag(1) + pkh(20)
+    address[0] = 0;
+    address[1] = 2;
+    for (int i = 0; i < 20; i++) {
+        address[2 + i] = (uint8_t)(i + 1);
+    }
+    ASSERT_EQUAL(0, tz_format_address(address, 22, obuf, sizeof(obuf)));
+    ASSERT_STR("tz3LRNhdn2ZwyH7255tuZhQWXw8uFiXNJRVw", obuf);
+    address[1] = 4;
+    ASSERT_NOT_EQUAL(0, tz_format_address(address, 22, obuf, sizeof(obuf)));
+
+    ASSERT_NOT_EQUAL(0, tz_format_base58check("scr1", address + 2, 20, obuf,
+                                              sizeof(obuf)));
+    ASSERT_NOT_EQUAL(0, tz_format_base58check_kind(TZ_BASE58CHECK_SRC1,
+                                                   address + 2, 20, obuf,
+                                                   sizeof(obuf)));
+}
+
+/* Line breaking of the BAGL devices before glyph-width tables: the
+ * prefix is shortened one character at a time until it is narrower
+ * than the screen, each width being computed from scratch */
+static size_t
+fit_by_shortening(const uint8_t *widths, const char *value, size_t will_fit,
+                  size_t max_width)
+{
+    size_t width;
+
+    will_fit++;
+    do {
+        will_fit--;
+        width = 0;
+        for (size_t i = 0; i < will_fit; i++) {
+            width += widths[(uint8_t)value[i]];
+        }
+    } while (width >= max_width);
+    return will_fit;
+}
+
+CTEST(ui_glyphs, check_fit_as_shortening)
+{
+    uint8_t  widths[TZ_UI_GLYPHS_COUNT];
+    char     value[40];
+    uint32_t seed = 1;
+
+    for (size_t c = 0; c < TZ_UI_GLYPHS_COUNT; c++) {
+        widths[c] = (uint8_t)(3 + ((c * 7) % 9));
+    }
+    widths['i'] = 0;
+    widths['W'] = 130;
+
+    for (size_t run = 0; run < 2000; run++) {
+        size_t length = run % sizeof(value);
+        for (size_t i = 0; i < length; i++) {
+            seed     = (seed * 1103515245u) + 12345u;
+            value[i] = (char)(0x20 + ((seed >> 16) % 0x5F));
+        }
+        for (size_t max_width = 1; max_width <= 128; max_width += 127) {
+            for (size_t n = 0; n <= length; n++) {
+                ASSERT_EQUAL_U(
+                    fit_by_shortening(widths, value, n, max_width),
+                    tz_ui_glyphs_fit(widths, value, n, max_width));
+            }
+        }
+    }
+
+    // a glyph wider than the screen fits nowhere
+    ASSERT_EQUAL_U(0, tz_ui_glyphs_fit(widths, "Wii", 3, 128));
+    ASSERT_EQUAL_U(3, tz_ui_glyphs_fit(widths, "iiiW", 4, 128));
+}
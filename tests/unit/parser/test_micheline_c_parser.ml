@@ -17,6 +17,17 @@ open Tezos_protocol_023_PtSeouLo
 open Tezos_micheline
 open Test_c_parser_utils
 
+(* Right combs [Pair a (Pair b c)] are printed flat as [Pair a b c].
+   The C parser only flattens pairs encoded with two arguments and no
+   annotations, which is how [to_bytes] encodes every pair matched
+   here. *)
+let rec flatten_comb (args : Protocol.Script_repr.node list) =
+  match args with
+  | [ x; Prim (_, Protocol.Michelson_v1_primitives.D_Pair, ([ _; _ ] as l), [])
+    ] ->
+      x :: flatten_comb l
+  | _ -> args
+
 let rec pp_node ~wrap ppf (node : Protocol.Script_repr.node) =
   match node with
   | String (_, s) -> Format.fprintf ppf "%S" s
@@ -31,6 +42,11 @@ let rec pp_node ~wrap ppf (node : Protocol.Script_repr.node) =
            (pp_node ~wrap:false))
         l
   | Prim (_, p, l, a) ->
+      let l =
+        if p = Protocol.Michelson_v1_primitives.D_Pair && a = [] then
+          flatten_comb l
+        else l
+      in
       let lwrap, rwrap =
         if wrap && (l <> [] || a <> []) then ("(", ")") else ("", "")
       in